@@ -0,0 +1,62 @@
+#include "alloc_counter.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifndef NDEBUG
+
+namespace {
+    std::atomic<std::size_t> allocations(0);
+}
+
+// Array, nothrow and sized forms all forward to these two by default
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+std::size_t debug::allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+std::size_t debug::allocationCount() {
+    return 0;
+}
+
+#endif
+
+namespace debug {
+
+    FrameAllocations::FrameAllocations(const char* loopName, int warmupFrames)
+        : name(loopName), warmup(warmupFrames) {}
+
+    void FrameAllocations::frameStart() {
+        startCount = allocationCount();
+    }
+
+    void FrameAllocations::frameEnd() {
+        std::size_t used = allocationCount() - startCount;
+        if (++frame <= warmup || used == 0) return;
+        unreported += used;
+        if (frame - lastReport >= 60) {
+            std::fprintf(stderr, "[alloc] %s: %zu heap allocations since the last report (frame %lld)\n",
+                name, unreported, frame);
+            unreported = 0;
+            lastReport = frame;
+        }
+    }
+
+}
@@ -0,0 +1,31 @@
+#ifndef ALLOC_COUNTER_HPP
+#define ALLOC_COUNTER_HPP
+
+#include <cstddef>
+
+// Debug builds count every global operator new, so a game loop can check that its
+// steady-state frames stay off the heap. Release builds (NDEBUG) compile to no-ops.
+namespace debug {
+
+    std::size_t allocationCount();      // always 0 in release builds
+
+    // Wrap each frame in frameStart()/frameEnd(); after the warm-up frames any frame
+    // that allocated is reported on stderr, at most about once a second
+    class FrameAllocations {
+    public:
+        explicit FrameAllocations(const char* loopName, int warmupFrames = 120);
+        void frameStart();
+        void frameEnd();
+
+    private:
+        const char* name;
+        int warmup;
+        long long frame = 0;
+        long long lastReport = -1000;
+        std::size_t startCount = 0;
+        std::size_t unreported = 0;
+    };
+
+}
+
+#endif // ALLOC_COUNTER_HPP
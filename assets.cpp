@@ -0,0 +1,99 @@
+#include "assets.hpp"
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    template<class T>
+    struct Slot {
+        std::unique_ptr<T> asset;   // null when loading failed
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::map<std::string, Slot<sf::Font>> fonts;
+        std::map<std::string, Slot<sf::SoundBuffer>> sounds;
+        std::map<std::string, Slot<sf::Texture>> textures;
+        std::thread preloader;
+
+        ~Registry() {
+            if (preloader.joinable())
+                preloader.join();
+        }
+    };
+
+    Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    std::string lower(std::string s) {
+        for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return s;
+    }
+
+    // First spelling of the name that exists on disk
+    std::string resolvePath(const std::string& name) {
+        std::string candidates[3] = { name, lower(name), lower(name) };
+        if (!candidates[2].empty())
+            candidates[2][0] = static_cast<char>(std::toupper(static_cast<unsigned char>(candidates[2][0])));
+        for (const std::string& path : candidates)
+            if (std::ifstream(path).good())
+                return path;
+        return name;
+    }
+
+    // The registry lock is held while a file loads, so a second request for the
+    // same file (from the preloader or a game) waits and then finds it loaded
+    template<class T>
+    const T* load(std::map<std::string, Slot<T>>& table, const std::string& name) {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        std::string key = lower(name);
+        auto it = table.find(key);
+        if (it == table.end()) {
+            Slot<T> slot;
+            slot.asset.reset(new T());
+            if (!slot.asset->loadFromFile(resolvePath(name)))
+                slot.asset.reset();
+            it = table.emplace(key, std::move(slot)).first;
+        }
+        return it->second.asset.get();
+    }
+
+}
+
+namespace Assets {
+
+    const sf::Font* font(const std::string& name) {
+        return load(registry().fonts, name);
+    }
+
+    const sf::SoundBuffer* sound(const std::string& name) {
+        return load(registry().sounds, name);
+    }
+
+    const sf::Texture* texture(const std::string& name) {
+        return load(registry().textures, name);
+    }
+
+    void preloadAsync(const std::vector<std::string>& fonts, const std::vector<std::string>& sounds,
+        const std::vector<std::string>& textures) {
+        Registry& r = registry();
+        if (r.preloader.joinable())
+            r.preloader.join();
+        r.preloader = std::thread([fonts, sounds, textures]() {
+            for (const std::string& f : fonts) font(f);
+            for (const std::string& s : sounds) sound(s);
+            for (const std::string& t : textures) texture(t);
+        });
+    }
+
+    void preloadGameAssets() {
+        preloadAsync({ "arial.ttf" }, { "food.mp3", "gameover.mp3" });
+    }
+
+}
@@ -0,0 +1,30 @@
+#ifndef ASSETS_HPP
+#define ASSETS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <string>
+#include <vector>
+
+// Process-wide fonts, sound buffers and textures. Each file is read and decoded once
+// and then shared by every game for the rest of the run. Names are matched without
+// regard to case, and on disk the name is tried as given, in lower case and
+// capitalised, so "Arial.ttf" and "arial.ttf" resolve to the same loaded font.
+// Lookups return nullptr when the file cannot be loaded; the failure is remembered.
+namespace Assets {
+
+    const sf::Font* font(const std::string& name = "arial.ttf");
+    const sf::SoundBuffer* sound(const std::string& name);
+    const sf::Texture* texture(const std::string& name);
+
+    // Loads the given files on a background thread. A lookup for a file still being
+    // preloaded waits for it instead of loading it twice. The thread is joined at exit.
+    void preloadAsync(const std::vector<std::string>& fonts, const std::vector<std::string>& sounds,
+        const std::vector<std::string>& textures = {});
+
+    // Everything the games use, for the main menu to warm up
+    void preloadGameAssets();
+
+}
+
+#endif // ASSETS_HPP
@@ -0,0 +1,151 @@
+#include "board_camera.hpp"
+#include <algorithm>
+
+BoardCamera::BoardCamera(float tileSize) : tileSize(tileSize) {}
+
+void BoardCamera::setArea(float width, float height, float windowWidth, float windowHeight) {
+    areaW = width;
+    areaH = height;
+    viewport = sf::FloatRect(0.f, 0.f, width / windowWidth, height / windowHeight);
+    apply();
+}
+
+void BoardCamera::setLimits(int newRows, int newCols) {
+    rows = newRows;
+    cols = newCols;
+    apply();
+}
+
+void BoardCamera::setZoomRange(float minPixelsPerTile, float maxPixelsPerTile) {
+    minZoom = minPixelsPerTile / tileSize;
+    maxZoom = std::max(minZoom, maxPixelsPerTile / tileSize);
+    apply();
+}
+
+void BoardCamera::centerOnTile(float row, float col) {
+    centre = sf::Vector2f((col + 0.5f) * tileSize, (row + 0.5f) * tileSize);
+    apply();
+}
+
+bool BoardCamera::handleEvent(const sf::Event& event) {
+    sf::Vector2f before = centre;
+    float zoomBefore = zoom;
+    switch (event.type) {
+    case sf::Event::MouseWheelScrolled:
+        if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel &&
+            inArea(event.mouseWheelScroll.x, event.mouseWheelScroll.y)) {
+            // Keep the world point under the cursor where it is
+            sf::Vector2f anchor = toWorld(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+            zoom = std::max(minZoom, std::min(maxZoom, zoom * std::pow(1.25f, event.mouseWheelScroll.delta)));
+            centre = anchor - sf::Vector2f(event.mouseWheelScroll.x - areaW / 2.f, event.mouseWheelScroll.y - areaH / 2.f) / zoom;
+        }
+        break;
+    case sf::Event::MouseButtonPressed:
+        if (event.mouseButton.button == sf::Mouse::Middle && inArea(event.mouseButton.x, event.mouseButton.y)) {
+            dragging = true;
+            dragFrom = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+        }
+        break;
+    case sf::Event::MouseButtonReleased:
+        if (event.mouseButton.button == sf::Mouse::Middle)
+            dragging = false;
+        break;
+    case sf::Event::MouseMoved:
+        if (dragging) {
+            sf::Vector2i to(event.mouseMove.x, event.mouseMove.y);
+            centre -= sf::Vector2f(static_cast<float>(to.x - dragFrom.x), static_cast<float>(to.y - dragFrom.y)) / zoom;
+            dragFrom = to;
+        }
+        break;
+    case sf::Event::KeyPressed: {
+        // Arrow keys move an eighth of the area
+        float stepX = areaW / 8.f / zoom, stepY = areaH / 8.f / zoom;
+        switch (event.key.code) {
+        case sf::Keyboard::Left: centre.x -= stepX; break;
+        case sf::Keyboard::Right: centre.x += stepX; break;
+        case sf::Keyboard::Up: centre.y -= stepY; break;
+        case sf::Keyboard::Down: centre.y += stepY; break;
+        case sf::Keyboard::Add: case sf::Keyboard::Equal:
+            zoom = std::min(maxZoom, zoom * 1.25f);
+            break;
+        case sf::Keyboard::Subtract: case sf::Keyboard::Hyphen:
+            zoom = std::max(minZoom, zoom / 1.25f);
+            break;
+        default: break;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    apply();
+    return centre != before || zoom != zoomBefore;
+}
+
+// Clamps zoom and centre, then rebuilds the view. A board narrower than the area is
+// centred; a wider one can be panned until its edge meets the area's edge.
+void BoardCamera::apply() {
+    zoom = std::max(minZoom, std::min(maxZoom, zoom));
+    float halfW = areaW / zoom / 2.f, halfH = areaH / zoom / 2.f;
+    if (cols >= 0) {
+        float boardW = cols * tileSize;
+        centre.x = boardW <= 2 * halfW ? boardW / 2.f : std::max(halfW, std::min(boardW - halfW, centre.x));
+    }
+    if (rows >= 0) {
+        float boardH = rows * tileSize;
+        centre.y = boardH <= 2 * halfH ? boardH / 2.f : std::max(halfH, std::min(boardH - halfH, centre.y));
+    }
+    cameraView.setCenter(centre);
+    cameraView.setSize(2 * halfW, 2 * halfH);
+    cameraView.setViewport(viewport);
+}
+
+sf::Vector2f BoardCamera::topLeft() const {
+    return centre - sf::Vector2f(areaW / 2.f, areaH / 2.f) / zoom;
+}
+
+sf::Vector2f BoardCamera::toWorld(int x, int y) const {
+    return topLeft() + sf::Vector2f(static_cast<float>(x), static_cast<float>(y)) / zoom;
+}
+
+bool BoardCamera::tileAt(int x, int y, int& row, int& col) const {
+    if (!inArea(x, y)) return false;
+    sf::Vector2f world = toWorld(x, y);
+    row = static_cast<int>(std::floor(world.y / tileSize));
+    col = static_cast<int>(std::floor(world.x / tileSize));
+    if (rows >= 0 && (row < 0 || row >= rows)) return false;
+    if (cols >= 0 && (col < 0 || col >= cols)) return false;
+    return true;
+}
+
+void BoardCamera::visibleTiles(int& firstRow, int& firstCol, int& lastRow, int& lastCol) const {
+    sf::Vector2f a = topLeft();
+    sf::Vector2f b = a + sf::Vector2f(areaW, areaH) / zoom;
+    firstRow = static_cast<int>(std::floor(a.y / tileSize));
+    firstCol = static_cast<int>(std::floor(a.x / tileSize));
+    lastRow = static_cast<int>(std::ceil(b.y / tileSize)) - 1;
+    lastCol = static_cast<int>(std::ceil(b.x / tileSize)) - 1;
+    if (rows >= 0) {
+        firstRow = std::max(firstRow, 0);
+        lastRow = std::min(lastRow, rows - 1);
+    }
+    if (cols >= 0) {
+        firstCol = std::max(firstCol, 0);
+        lastCol = std::min(lastCol, cols - 1);
+    }
+}
+
+void TilePixelMap::upload(const BoardCamera& camera, unsigned width, unsigned height) {
+    if (texture.getSize() != sf::Vector2u(width, height)) {
+        texture.create(width, height);
+        sprite.setTexture(texture, true);
+    }
+    texture.update(pixels.data());
+    // Drawn through the camera's view, so one texel must cover one screen pixel
+    sprite.setPosition(camera.topLeft());
+    sprite.setScale(1.f / camera.pixelsPerUnit(), 1.f / camera.pixelsPerUnit());
+}
+
+void TilePixelMap::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    target.draw(sprite, states);
+}
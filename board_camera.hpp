@@ -0,0 +1,99 @@
+#ifndef BOARD_CAMERA_HPP
+#define BOARD_CAMERA_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <vector>
+
+// Pan and zoom over a grid of square tiles shown in a rectangle at the top-left of
+// the window. World units are pixels at zoom 1, so tile (r, c) covers
+// [c * tileSize, (c + 1) * tileSize) across and [r * tileSize, (r + 1) * tileSize) down.
+// Draw the board with view(); everything else keeps the window's own view.
+class BoardCamera {
+public:
+    explicit BoardCamera(float tileSize);
+
+    // Board area and window size in pixels; the area starts at the window's top-left
+    void setArea(float width, float height, float windowWidth, float windowHeight);
+    // Tiles the camera may show. Without limits it pans anywhere, for endless boards.
+    void setLimits(int rows, int cols);
+    void setZoomRange(float minPixelsPerTile, float maxPixelsPerTile);
+    void centerOnTile(float row, float col);
+
+    // Mouse wheel zooms about the cursor, +/- about the centre; a middle-button drag
+    // or the arrow keys pan. True when the camera moved.
+    bool handleEvent(const sf::Event& event);
+
+    const sf::View& view() const { return cameraView; }
+    float pixelsPerTile() const { return tileSize * zoom; }
+    float pixelsPerUnit() const { return zoom; }
+    sf::Vector2f topLeft() const;       // world point at the area's top-left corner
+    sf::Vector2f center() const { return centre; }
+    float areaWidth() const { return areaW; }
+    float areaHeight() const { return areaH; }
+
+    bool inArea(int x, int y) const { return x >= 0 && y >= 0 && x < areaW && y < areaH; }
+    // Window pixel to world point; the inverse of the transform view() applies
+    sf::Vector2f toWorld(int x, int y) const;
+    // Tile under a window pixel; false outside the area or the limits
+    bool tileAt(int x, int y, int& row, int& col) const;
+    // Inclusive range of tiles at least partly on screen, clipped to the limits
+    void visibleTiles(int& firstRow, int& firstCol, int& lastRow, int& lastCol) const;
+
+private:
+    void apply();
+
+    float tileSize;
+    float areaW = 0, areaH = 0;
+    sf::FloatRect viewport;
+    int rows = -1, cols = -1;           // -1: no limits
+    float zoom = 1.f;                   // screen pixels per world unit
+    float minZoom = 1.f, maxZoom = 1.f;
+    sf::Vector2f centre;
+    bool dragging = false;
+    sf::Vector2i dragFrom;
+    sf::View cameraView;
+};
+
+// Zoomed-out board: one texel per screen pixel of the board area, each the colour of
+// the tile under that pixel's centre. Building it costs the area's pixel count
+// whatever the size of the board, and drawing it is one textured quad.
+class TilePixelMap : public sf::Drawable {
+public:
+    // colorOf(row, col) gives the colour of any tile, including ones off the board
+    template<class ColorOf>
+    void build(const BoardCamera& camera, float tileSize, ColorOf colorOf);
+
+private:
+    void upload(const BoardCamera& camera, unsigned width, unsigned height);
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    std::vector<sf::Uint8> pixels;      // RGBA
+    sf::Texture texture;
+    sf::Sprite sprite;
+};
+
+template<class ColorOf>
+void TilePixelMap::build(const BoardCamera& camera, float tileSize, ColorOf colorOf) {
+    const unsigned width = static_cast<unsigned>(camera.areaWidth());
+    const unsigned height = static_cast<unsigned>(camera.areaHeight());
+    pixels.resize(static_cast<size_t>(width) * height * 4);
+
+    const sf::Vector2f origin = camera.topLeft();
+    const float tilesPerPixel = 1.f / camera.pixelsPerTile();
+    sf::Uint8* out = pixels.data();
+    for (unsigned y = 0; y < height; ++y) {
+        int row = static_cast<int>(std::floor(origin.y / tileSize + (y + 0.5f) * tilesPerPixel));
+        for (unsigned x = 0; x < width; ++x) {
+            int col = static_cast<int>(std::floor(origin.x / tileSize + (x + 0.5f) * tilesPerPixel));
+            sf::Color color = colorOf(row, col);
+            *out++ = color.r;
+            *out++ = color.g;
+            *out++ = color.b;
+            *out++ = color.a;
+        }
+    }
+    upload(camera, width, height);
+}
+
+#endif // BOARD_CAMERA_HPP
@@ -0,0 +1,130 @@
+#include "card_deck.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+
+    bool isImage(const std::filesystem::path& path) {
+        std::string ext = path.extension().string();
+        for (char& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp";
+    }
+
+    // Centre square of the image, box-filtered down (or sampled up) to size x size
+    std::vector<sf::Uint8> fitCell(const sf::Image& image, unsigned size) {
+        std::vector<sf::Uint8> out(static_cast<std::size_t>(size) * size * 4);
+        sf::Vector2u dim = image.getSize();
+        unsigned side = std::min(dim.x, dim.y);
+        unsigned left = (dim.x - side) / 2, top = (dim.y - side) / 2;
+        const sf::Uint8* src = image.getPixelsPtr();
+        float scale = static_cast<float>(side) / size;
+
+        sf::Uint8* dst = out.data();
+        for (unsigned y = 0; y < size; ++y) {
+            unsigned y0 = top + static_cast<unsigned>(y * scale);
+            unsigned y1 = std::max(y0 + 1, top + static_cast<unsigned>((y + 1) * scale));
+            for (unsigned x = 0; x < size; ++x) {
+                unsigned x0 = left + static_cast<unsigned>(x * scale);
+                unsigned x1 = std::max(x0 + 1, left + static_cast<unsigned>((x + 1) * scale));
+                unsigned sum[4] = { 0, 0, 0, 0 };
+                for (unsigned sy = y0; sy < y1; ++sy) {
+                    const sf::Uint8* p = src + (static_cast<std::size_t>(sy) * dim.x + x0) * 4;
+                    for (unsigned sx = x0; sx < x1; ++sx, p += 4)
+                        for (int k = 0; k < 4; ++k) sum[k] += p[k];
+                }
+                unsigned count = (y1 - y0) * (x1 - x0);
+                for (int k = 0; k < 4; ++k)
+                    *dst++ = static_cast<sf::Uint8>(sum[k] / count);
+            }
+        }
+        return out;
+    }
+
+}
+
+CardDeck::~CardDeck() {
+    stopping = true;
+    if (decoder.joinable())
+        decoder.join();
+}
+
+bool CardDeck::load(const std::string& dir, int maxFaces) {
+    std::error_code error;
+    std::vector<std::string> found;
+    for (std::filesystem::directory_iterator it(dir, error), end; !error && it != end; it.increment(error))
+        if (it->is_regular_file(error) && isImage(it->path()))
+            found.push_back(it->path().string());
+    if (found.empty()) return false;
+    std::sort(found.begin(), found.end());
+
+    // A square grid of cells, no larger than the driver allows
+    unsigned maxColumns = std::max(1u, sf::Texture::getMaximumSize() / CELL_SIZE);
+    std::size_t limit = std::min<std::size_t>(static_cast<std::size_t>(std::max(0, maxFaces)),
+        static_cast<std::size_t>(maxColumns) * maxColumns);
+    if (found.size() > limit) found.resize(limit);
+    if (found.empty()) return false;
+    columns = static_cast<unsigned>(std::ceil(std::sqrt(static_cast<double>(found.size()))));
+    unsigned rows = static_cast<unsigned>((found.size() + columns - 1) / columns);
+    if (!atlas.create(columns * CELL_SIZE, rows * CELL_SIZE)) return false;
+    atlas.setSmooth(true);
+
+    files = std::move(found);
+    faceReady.assign(files.size(), false);
+    clock.restart();
+    decoder = std::thread(&CardDeck::decodeAll, this);
+    return true;
+}
+
+// Decodes in name order and hands each cell over as soon as it is done, so the first
+// faces show while the rest are still on disk
+void CardDeck::decodeAll() {
+    for (int face = 0; face < static_cast<int>(files.size()) && !stopping; ++face) {
+        sf::Image image;
+        Decoded cell{ face, {} };
+        if (image.loadFromFile(files[face]) && image.getSize().x > 0 && image.getSize().y > 0)
+            cell.pixels = fitCell(image, CELL_SIZE);
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded.push_back(std::move(cell));
+    }
+}
+
+bool CardDeck::poll() {
+    if (!loading()) return false;
+    std::vector<Decoded> arrived;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        arrived.swap(decoded);
+    }
+    for (const Decoded& cell : arrived) {
+        if (cell.pixels.empty()) {
+            std::cout << "Card image could not be loaded: " << files[cell.face] << "\n";
+            failed++;
+            continue;
+        }
+        unsigned x = cell.face % columns * CELL_SIZE, y = cell.face / columns * CELL_SIZE;
+        atlas.update(cell.pixels.data(), CELL_SIZE, CELL_SIZE, x, y);
+        faceReady[cell.face] = true;
+        uploaded++;
+    }
+
+    if (!arrived.empty() && !loading()) {
+        seconds = clock.getElapsedTime().asSeconds();
+        sf::Vector2u size = atlas.getSize();
+        std::cout << "Card deck: " << uploaded << " faces in " << static_cast<int>(seconds * 1000) << " ms, atlas "
+            << size.x << "x" << size.y << " (" << atlasBytes() / 1024 << " KB)\n";
+    }
+    return !arrived.empty();
+}
+
+sf::FloatRect CardDeck::texRect(int face) const {
+    return sf::FloatRect(static_cast<float>(face % columns * CELL_SIZE), static_cast<float>(face / columns * CELL_SIZE),
+        static_cast<float>(CELL_SIZE), static_cast<float>(CELL_SIZE));
+}
+
+std::size_t CardDeck::atlasBytes() const {
+    sf::Vector2u size = atlas.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4;
+}
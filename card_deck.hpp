@@ -0,0 +1,65 @@
+#ifndef CARD_DECK_HPP
+#define CARD_DECK_HPP
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Card face images from a directory, packed into one atlas texture so a whole deck
+// draws from a single texture. A background thread decodes the files and scales each
+// into a square cell; poll() uploads finished cells on the main thread, which owns
+// the GL context. Faces not uploaded yet report !ready(), so the game shows a
+// placeholder for them while the rest of the deck streams in.
+class CardDeck {
+public:
+    static constexpr unsigned CELL_SIZE = 96;   // pixels per face in the atlas
+
+    CardDeck() = default;
+    ~CardDeck();
+    CardDeck(const CardDeck&) = delete;
+    CardDeck& operator=(const CardDeck&) = delete;
+
+    // Starts loading up to maxFaces .png/.jpg/.bmp files from dir, in name order.
+    // False when the directory holds no images; the deck then stays empty.
+    bool load(const std::string& dir, int maxFaces);
+    // Uploads the cells decoded since the last call; true if any arrived.
+    // Prints the load report once the last one is in.
+    bool poll();
+
+    bool loading() const { return uploaded + failed < static_cast<int>(files.size()); }
+    int faceCount() const { return static_cast<int>(files.size()); }
+    int loadedCount() const { return uploaded; }
+    bool ready(int face) const { return face >= 0 && face < faceCount() && faceReady[face]; }
+    sf::FloatRect texRect(int face) const;
+    const sf::Texture& texture() const { return atlas; }
+
+    double loadSeconds() const { return seconds; }                  // load() to last upload
+    std::size_t atlasBytes() const;                                 // texture memory, RGBA
+
+private:
+    struct Decoded {
+        int face;
+        std::vector<sf::Uint8> pixels;  // CELL_SIZE squared RGBA, empty when decoding failed
+    };
+
+    void decodeAll();
+
+    std::vector<std::string> files;
+    std::vector<bool> faceReady;
+    unsigned columns = 0;               // cells per atlas row
+    sf::Texture atlas;
+    int uploaded = 0;
+    int failed = 0;
+    sf::Clock clock;
+    double seconds = 0;
+
+    std::mutex mutex;
+    std::vector<Decoded> decoded;       // handed from the decoder to poll()
+    std::atomic<bool> stopping{ false };
+    std::thread decoder;
+};
+
+#endif // CARD_DECK_HPP
@@ -1,127 +1,157 @@
 #include <SFML/Graphics.hpp>
-#include <vector>
+#include "ConnectFour.hpp"
+#include "core/connectfour_book.hpp"
+#include "core/connectfour_search.hpp"
+#include "assets.hpp"
 #include <iostream>
+#include <string>
 #include <algorithm>
+#include <future>
+#include <thread>
 
-class ConnectFour {
+class ConnectFour : public Scene {
 public:
-    static const int ROWS = 6;
-    static const int COLS = 7;
+    static const int ROWS = core::ConnectFourGame::ROWS;
+    static const int COLS = core::ConnectFourGame::COLS;
     static const int CELL_SIZE = 100;
-    static const int WIN_COUNT = 4;
+    static const int WIN_COUNT = core::ConnectFourGame::WIN_COUNT;
+    static const int AI_TIME_BUDGET_MS = 1000;
+    static const int AI_TT_SIZE_MB = 64;
 
-    enum Player { NONE = 0, RED, YELLOW };
+    using Player = core::ConnectFourGame::Player;
 
-    ConnectFour() : board(ROWS, std::vector<Player>(COLS, NONE)), currentPlayer(RED), gameOver(false) {
-        if (!font.loadFromFile("Arial.ttf")) {
+    ConnectFour() : engine(AI_TT_SIZE_MB, std::max(1u, std::thread::hardware_concurrency())), vsComputer(false), thinking(false) {
+        if (const sf::Font* loaded = Assets::font("Arial.ttf"))
+            font = loaded;
+        else
             std::cerr << "Font loading failed.\n";
-        }
-        statusText.setFont(font);
-        statusText.setCharacterSize(24);
+        statusText.setFont(*font);
+        statusText.setCharacterSize(18);
         statusText.setFillColor(sf::Color::Black);
-        statusText.setPosition(10, ROWS * CELL_SIZE + 10);  // Position below the board
+        statusText.setPosition(10, ROWS * CELL_SIZE + 5);  // Position below the board
+        book.open("connectfour_book.bin");  // optional, built offline by connectfour_book_gen
+        resetGame();
     }
 
-    void play(sf::RenderWindow& window) {
-        resetGame();
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, COLS * CELL_SIZE, ROWS * CELL_SIZE + 60, "Connect Four");
+    }
 
-        while (window.isOpen()) {
-            sf::Event event;
-            while (window.pollEvent(event)) {
-                if (event.type == sf::Event::Closed)
-                    window.close();
-
-                if (!gameOver && event.type == sf::Event::MouseButtonPressed) {
-                    int col = event.mouseButton.x / CELL_SIZE;
-                    if (col >= 0 && col < COLS && dropToken(col, currentPlayer)) {
-                        if (checkWin(currentPlayer)) {
-                            gameOver = true;
-                            winnerText = (currentPlayer == RED ? "Red wins!" : "Yellow wins!");
-                        }
-                        else {
-                            currentPlayer = (currentPlayer == RED ? YELLOW : RED);
-                        }
-                    }
-                }
+    void handleEvent(const sf::Event& event) override {
+        if (!game.gameOver && !thinking && event.type == sf::Event::MouseButtonPressed) {
+            int col = event.mouseButton.x / CELL_SIZE;
+            if (game.apply(col)) {
+                onMovePlayed();
+                if (vsComputer && !game.gameOver)
+                    startComputerMove();
+            }
+        }
 
-                if (gameOver && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::R) {
-                    resetGame();
-                }
+        // Toggle the computer opponent (it plays Yellow)
+        if (!thinking && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::C) {
+            vsComputer = !vsComputer;
+            updateStatus();
+            if (vsComputer && !game.gameOver && game.currentPlayer == core::ConnectFourGame::YELLOW)
+                startComputerMove();
+        }
 
-            }
+        if (game.gameOver && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::R) {
+            resetGame();
+        }
+    }
 
-            draw(window);
+    void update(float) override {
+        // The search runs on worker threads; pick up its move once it is done
+        if (thinking && pendingSearch.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            lastSearch = pendingSearch.get();
+            thinking = false;
+            game.apply(lastSearch.move);
+            onMovePlayed();
+            updateStatus();
+            redraw();
         }
     }
 
+    // Idle until clicked, except to check on a running search
+    sf::Time wakeAfter() const override {
+        return thinking ? sf::milliseconds(50) : WAIT_FOR_INPUT;
+    }
+
+    // Leaving mid-search: stop the workers so the pending future returns at once
+    void exit() override {
+        engine.stop();
+    }
+
 private:
-    std::vector<std::vector<Player>> board;
-    Player currentPlayer;
-    bool gameOver;
+    core::ConnectFourGame game;
+    core::ConnectFourSearch engine;
+    core::OpeningBook book;
+    bool lastMoveFromBook = false;
+    core::SearchResult lastSearch;
+    std::future<core::SearchResult> pendingSearch;
+    bool vsComputer;
+    bool thinking;
     std::string winnerText;
-    sf::Font font;
+    const sf::Font* font = &fallbackFont;
+    sf::Font fallbackFont;      // empty, used when the font file is missing
     sf::Text statusText;
 
-    bool dropToken(int col, Player player) {
-        for (int row = ROWS - 1; row >= 0; --row) {
-            if (board[row][col] == NONE) {
-                board[row][col] = player;
-                return true;
-            }
-        }
-        return false;
+    void resetGame() {
+        game.reset();
+        winnerText = "";
+        lastSearch = core::SearchResult();
+        lastMoveFromBook = false;
+        updateStatus();
     }
 
-    bool checkWin(Player player) {
-        // Horizontal check
-        for (int row = 0; row < ROWS; ++row)
-            for (int col = 0; col <= COLS - WIN_COUNT; ++col)
-                if (std::all_of(board[row].begin() + col, board[row].begin() + col + WIN_COUNT,
-                    [=](Player p) { return p == player; }))
-                    return true;
-
-        // Vertical check
-        for (int col = 0; col < COLS; ++col)
-            for (int row = 0; row <= ROWS - WIN_COUNT; ++row) {
-                bool win = true;
-                for (int i = 0; i < WIN_COUNT; ++i)
-                    if (board[row + i][col] != player)
-                        win = false;
-                if (win) return true;
-            }
-
-        // Diagonal down-left check
-        for (int row = WIN_COUNT - 1; row < ROWS; ++row)
-            for (int col = 0; col <= COLS - WIN_COUNT; ++col) {
-                bool win = true;
-                for (int i = 0; i < WIN_COUNT; ++i)
-                    if (board[row - i][col + i] != player)
-                        win = false;
-                if (win) return true;
-            }
+    void onMovePlayed() {
+        if (!game.gameOver) return;
+        switch (game.winner) {
+        case core::ConnectFourGame::RED:    winnerText = "Red wins!"; break;
+        case core::ConnectFourGame::YELLOW: winnerText = "Yellow wins!"; break;
+        default:                            winnerText = "It's a draw!"; break;
+        }
+    }
 
-        // Diagonal down-right check
-        for (int row = 0; row <= ROWS - WIN_COUNT; ++row)
-            for (int col = 0; col <= COLS - WIN_COUNT; ++col) {
-                bool win = true;
-                for (int i = 0; i < WIN_COUNT; ++i)
-                    if (board[row + i][col + i] != player)
-                        win = false;
-                if (win) return true;
-            }
+    void startComputerMove() {
+        core::OpeningBook::Entry entry;
+        if (book.lookup(game.board, entry)) {
+            lastMoveFromBook = true;
+            game.apply(entry.move);
+            onMovePlayed();
+            updateStatus();
+            return;
+        }
 
-        return false;
+        lastMoveFromBook = false;
+        core::ConnectFourBoard board = game.board;
+        thinking = true;
+        engine.resume();
+        pendingSearch = std::async(std::launch::async, [this, board] {
+            return engine.search(board, AI_TIME_BUDGET_MS);
+            });
+        updateStatus();
     }
 
-    void resetGame() {
-        for (auto& row : board)
-            std::fill(row.begin(), row.end(), NONE);
-        currentPlayer = RED;
-        gameOver = false;
-        winnerText = "";
+    void updateStatus() {
+        std::string status = vsComputer ? "vs Computer ('C' for 2 players)" : "2 players ('C' for computer)";
+        if (thinking) {
+            status += "\nComputer is thinking...";
+        }
+        else if (vsComputer && lastMoveFromBook) {
+            status += "\nbook move";
+        }
+        else if (vsComputer && lastSearch.move >= 0) {
+            status += "\ndepth " + std::to_string(lastSearch.depth) + (lastSearch.solved ? " solved" : "") +
+                ", " + std::to_string(engine.threadCount()) + " threads" +
+                ", " + std::to_string(static_cast<int>(lastSearch.nodesPerSecond() / 1000)) + "k nodes/s" +
+                ", TT hits " + std::to_string(static_cast<int>(100 * lastSearch.ttHitRate())) + "%";
+        }
+        statusText.setString(status);
     }
 
-    void draw(sf::RenderWindow& window) {
+public:
+    void render(sf::RenderWindow& window) override {
         window.clear(sf::Color::White);
 
         // Draw background grid
@@ -140,16 +170,16 @@ private:
                 float centerY = row * CELL_SIZE + CELL_SIZE / 2;
                 token.setPosition(centerX - token.getRadius(), centerY - token.getRadius());
 
-                switch (board[row][col]) {
-                case RED:    token.setFillColor(sf::Color::Red); break;
-                case YELLOW: token.setFillColor(sf::Color::Yellow); break;
+                switch (game.at(row, col)) {
+                case core::ConnectFourGame::RED:    token.setFillColor(sf::Color::Red); break;
+                case core::ConnectFourGame::YELLOW: token.setFillColor(sf::Color::Yellow); break;
                 default:     token.setFillColor(sf::Color(230, 230, 230)); break;
                 }
 
                 window.draw(token);
             }
         }
-        if (gameOver) {
+        if (game.gameOver) {
             // Draw horizontal overlay: full width, fixed height
             float overlayHeight = 200;
             sf::RectangleShape overlay(sf::Vector2f(COLS * CELL_SIZE, overlayHeight));
@@ -160,7 +190,7 @@ private:
             window.draw(overlay);
 
             // Winner message
-            sf::Text result(winnerText, font, 36);
+            sf::Text result(winnerText, *font, 36);
             result.setFillColor(sf::Color::Red);
             result.setStyle(sf::Text::Bold);
             float resultX = (COLS * CELL_SIZE - result.getLocalBounds().width) / 2;
@@ -169,7 +199,7 @@ private:
             window.draw(result);
 
             // Restart instruction
-            sf::Text restart("Press 'R' to restart", font, 24);
+            sf::Text restart("Press 'R' to restart", *font, 24);
             restart.setFillColor(sf::Color::Black);
             float restartX = (COLS * CELL_SIZE - restart.getLocalBounds().width) / 2;
             restart.setPosition(restartX, resultY + 50);
@@ -177,13 +207,9 @@ private:
         }
 
         window.draw(statusText);
-        window.display();
     }
 };
 
-// Launcher
-void playConnectFourGame() {
-    sf::RenderWindow window(sf::VideoMode(ConnectFour::COLS * ConnectFour::CELL_SIZE, ConnectFour::ROWS * ConnectFour::CELL_SIZE + 60), "Connect Four");
-    ConnectFour game;
-    game.play(window);
+std::unique_ptr<Scene> makeConnectFourScene() {
+    return std::make_unique<ConnectFour>();
 }
@@ -1,6 +1,8 @@
 #ifndef CONNECT_FOUR_HPP
 #define CONNECT_FOUR_HPP
 
-void playConnectFourGame();  // Simple entry point
+#include "scene.hpp"
+
+std::unique_ptr<Scene> makeConnectFourScene();  // Simple entry point
 
 #endif
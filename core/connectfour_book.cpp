@@ -0,0 +1,122 @@
+#include "connectfour_book.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+
+    uint64_t OpeningBook::canonicalKey(const ConnectFourBoard& board, bool& mirrored) {
+        uint64_t key = board.key();
+        uint64_t flipped = ConnectFourBoard::mirror(key);
+        mirrored = flipped < key;
+        return mirrored ? flipped : key;
+    }
+
+    uint64_t OpeningBook::packRecord(uint64_t key, int move, int score) {
+        return (key << 15) | (uint64_t(move & 7) << 12) | uint64_t((score + 2048) & 0xFFF);
+    }
+
+    bool OpeningBook::write(const std::string& path, int maxPly, std::vector<uint64_t>& out) {
+        std::sort(out.begin(), out.end());
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) return false;
+
+        Header header;
+        memcpy(header.magic, "C4BK", 4);
+        header.version = VERSION;
+        header.maxPly = static_cast<uint32_t>(maxPly);
+        header.count = static_cast<uint32_t>(out.size());
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(out.data(), sizeof(uint64_t), out.size(), file) == out.size();
+        return fclose(file) == 0 && ok;
+    }
+
+    bool OpeningBook::open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        HANDLE map = nullptr;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= static_cast<LONGLONG>(sizeof(Header)))
+            map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = map ? MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (map) CloseHandle(map);
+            CloseHandle(file);
+            return false;
+        }
+        fileHandle = file;
+        mapHandle = map;
+        mapping = view;
+        mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+            ::close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);    // the mapping keeps the file alive
+        if (view == MAP_FAILED) return false;
+        mapping = view;
+        mappedSize = static_cast<size_t>(st.st_size);
+#endif
+
+        const Header* header = static_cast<const Header*>(mapping);
+        if (memcmp(header->magic, "C4BK", 4) != 0 || header->version != VERSION ||
+            sizeof(Header) + size_t(header->count) * sizeof(uint64_t) > mappedSize) {
+            close();
+            return false;
+        }
+        records = reinterpret_cast<const uint64_t*>(static_cast<const char*>(mapping) + sizeof(Header));
+        count = header->count;
+        maxPly = static_cast<int>(header->maxPly);
+        return true;
+    }
+
+    void OpeningBook::close() {
+        if (!mapping) return;
+#ifdef _WIN32
+        UnmapViewOfFile(mapping);
+        CloseHandle(mapHandle);
+        CloseHandle(fileHandle);
+        mapHandle = fileHandle = nullptr;
+#else
+        munmap(mapping, mappedSize);
+#endif
+        mapping = nullptr;
+        mappedSize = 0;
+        records = nullptr;
+        count = 0;
+        maxPly = 0;
+    }
+
+    bool OpeningBook::lookup(const ConnectFourBoard& board, Entry& out) const {
+        if (!records || board.moves > maxPly) return false;
+
+        bool mirrored;
+        uint64_t key = canonicalKey(board, mirrored);
+        const uint64_t* end = records + count;
+        const uint64_t* it = std::lower_bound(records, end, key << 15);
+        if (it == end || (*it >> 15) != key) return false;
+
+        int move = static_cast<int>((*it >> 12) & 7);
+        out.move = mirrored ? ConnectFourBoard::COLS - 1 - move : move;
+        out.score = static_cast<int>(*it & 0xFFF) - 2048;
+        return board.canPlay(out.move);
+    }
+
+}
@@ -0,0 +1,62 @@
+#ifndef CONNECTFOUR_BOOK_HPP
+#define CONNECTFOUR_BOOK_HPP
+
+#include "connectfour_core.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+    // Opening book file: a 16 byte header followed by `count` little-endian uint64_t
+    // records sorted ascending. Each record is key << 15 | move << 12 | (score + 2048),
+    // where key is the smaller of the position key and its mirror image.
+    class OpeningBook {
+    public:
+        static const uint32_t VERSION = 1;
+
+        struct Header {
+            char magic[4];      // "C4BK"
+            uint32_t version;
+            uint32_t maxPly;
+            uint32_t count;
+        };
+
+        struct Entry {
+            int move;
+            int score;
+        };
+
+        OpeningBook() : mapping(nullptr), mappedSize(0), records(nullptr), count(0), maxPly(0) {}
+        ~OpeningBook() { close(); }
+        OpeningBook(const OpeningBook&) = delete;
+        OpeningBook& operator=(const OpeningBook&) = delete;
+
+        bool open(const std::string& path);    // maps the file read-only, no parsing
+        void close();
+        bool isOpen() const { return records != nullptr; }
+        size_t size() const { return count; }
+        int depth() const { return maxPly; }
+
+        bool lookup(const ConnectFourBoard& board, Entry& out) const;
+
+        static uint64_t canonicalKey(const ConnectFourBoard& board, bool& mirrored);
+        static uint64_t packRecord(uint64_t key, int move, int score);
+        static bool write(const std::string& path, int maxPly, std::vector<uint64_t>& records);  // sorts records
+
+    private:
+        void* mapping;
+        size_t mappedSize;
+        const uint64_t* records;
+        size_t count;
+        int maxPly;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mapHandle = nullptr;
+#endif
+    };
+
+}
+
+#endif // CONNECTFOUR_BOOK_HPP
@@ -0,0 +1,52 @@
+#include "connectfour_core.hpp"
+
+namespace core {
+
+    void ConnectFourBoard::reset() {
+        stones[0] = stones[1] = 0;
+        for (int col = 0; col < COLS; ++col)
+            height[col] = static_cast<uint8_t>(col * HEIGHT);
+        moves = 0;
+    }
+
+    ConnectFourGame::ConnectFourGame() {
+        reset();
+    }
+
+    void ConnectFourGame::reset(uint32_t) {
+        board.reset();
+        currentPlayer = RED;
+        winner = NONE;
+        gameOver = false;
+        moveCount = 0;
+    }
+
+    ConnectFourGame::Player ConnectFourGame::at(int row, int col) const {
+        uint64_t bit = uint64_t(1) << (col * ConnectFourBoard::HEIGHT + (ROWS - 1 - row));
+        if (board.stones[0] & bit) return RED;
+        if (board.stones[1] & bit) return YELLOW;
+        return NONE;
+    }
+
+    bool ConnectFourGame::apply(int col) {
+        if (gameOver || !canPlay(col))
+            return false;
+
+        bool won = board.isWinningMove(col);
+        board.play(col);
+        moveCount = board.moves;
+
+        if (won) {
+            gameOver = true;
+            winner = currentPlayer;
+        }
+        else if (moveCount == ROWS * COLS) {
+            gameOver = true;
+        }
+        else {
+            currentPlayer = (currentPlayer == RED ? YELLOW : RED);
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,113 @@
+#ifndef CONNECTFOUR_CORE_HPP
+#define CONNECTFOUR_CORE_HPP
+
+#include <cstdint>
+
+namespace core {
+
+    // Bitboard position. Bit (col * HEIGHT + row) is a cell with row 0 at the bottom;
+    // the spare bit on top of each column stays empty so shifted lines never wrap.
+    struct ConnectFourBoard {
+        static const int ROWS = 6;
+        static const int COLS = 7;
+        static const int HEIGHT = ROWS + 1;
+        static constexpr uint64_t BOTTOM_MASK = 0x40810204081ull;   // lowest cell of every column
+        static constexpr uint64_t BOARD_MASK = BOTTOM_MASK * ((1ull << ROWS) - 1);
+
+        uint64_t stones[2];     // side 0 moves first
+        uint8_t height[COLS];   // bit index of the next free cell in each column
+        int moves;
+
+        void reset();
+
+        bool canPlay(int col) const { return height[col] < col * HEIGHT + ROWS; }
+        int sideToMove() const { return moves & 1; }
+        uint64_t occupied() const { return stones[0] | stones[1]; }
+        uint64_t moveBit(int col) const { return uint64_t(1) << height[col]; }
+
+        // Both expect a legal column
+        void play(int col) {
+            stones[moves & 1] |= moveBit(col);
+            height[col]++;
+            moves++;
+        }
+        void undo(int col) {
+            moves--;
+            height[col]--;
+            stones[moves & 1] &= ~moveBit(col);
+        }
+
+        bool isWinningMove(int col) const {
+            uint64_t move = moveBit(col);
+            return alignedThrough(stones[moves & 1] | move, move);
+        }
+
+        // Bits of every playable cell
+        uint64_t possible() const { return (occupied() + BOTTOM_MASK) & BOARD_MASK; }
+
+        // Unique per position: side-to-move stones plus the occupancy mask
+        uint64_t key() const { return stones[moves & 1] + occupied(); }
+
+        // Same layout with the columns reversed; key() commutes with this since columns never carry
+        static uint64_t mirror(uint64_t bits) {
+            uint64_t out = 0;
+            for (int col = 0; col < COLS; ++col)
+                out |= ((bits >> (col * HEIGHT)) & 0x7F) << ((COLS - 1 - col) * HEIGHT);
+            return out;
+        }
+
+        // True if `stones` holds a line of four passing through the single bit `move`
+        static bool alignedThrough(uint64_t stones, uint64_t move) {
+            const int dirs[4] = { 1, HEIGHT, HEIGHT + 1, HEIGHT - 1 };   // vertical, horizontal, two diagonals
+            for (int d : dirs) {
+                uint64_t pairs = stones & (stones >> d);
+                uint64_t starts = pairs & (pairs >> (2 * d));
+                if (starts & (move | (move >> d) | (move >> (2 * d)) | (move >> (3 * d))))
+                    return true;
+            }
+            return false;
+        }
+
+        // Empty cells (reachable or not) that would complete a line of four for `stones`
+        static uint64_t winningCells(uint64_t stones, uint64_t occupied) {
+            uint64_t r = (stones << 1) & (stones << 2) & (stones << 3);
+            const int dirs[3] = { HEIGHT, HEIGHT + 1, HEIGHT - 1 };
+            for (int d : dirs) {
+                uint64_t p = (stones << d) & (stones << (2 * d));
+                r |= p & (stones << (3 * d));
+                r |= p & (stones >> d);
+                p = (stones >> d) & (stones >> (2 * d));
+                r |= p & (stones << d);
+                r |= p & (stones >> (3 * d));
+            }
+            return r & (BOARD_MASK ^ occupied);
+        }
+    };
+
+    class ConnectFourGame {
+    public:
+        static const int ROWS = ConnectFourBoard::ROWS;
+        static const int COLS = ConnectFourBoard::COLS;
+        static const int WIN_COUNT = 4;
+
+        enum Player { NONE = 0, RED, YELLOW };
+
+        ConnectFourGame();
+
+        void reset(uint32_t seed = 0);
+        bool apply(int col);        // drops a token for the side to move, false if the column is full
+        void step(float) {}         // turn based, nothing advances with time
+
+        Player at(int row, int col) const;      // row 0 is the top of the board
+        bool canPlay(int col) const { return col >= 0 && col < COLS && board.canPlay(col); }
+
+        ConnectFourBoard board;
+        Player currentPlayer;
+        Player winner;              // NONE on a draw
+        bool gameOver;
+        int moveCount;
+    };
+
+}
+
+#endif // CONNECTFOUR_CORE_HPP
@@ -0,0 +1,285 @@
+#include "connectfour_search.hpp"
+#include <algorithm>
+#include <bitset>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+    namespace {
+
+        const int columnOrder[ConnectFourBoard::COLS] = { 3, 2, 4, 1, 5, 0, 6 };   // center first
+
+        int popcount(uint64_t x) {
+            return static_cast<int>(std::bitset<64>(x).count());
+        }
+
+        // data word: score (16 bits, biased) | depth (8) | bound (2) | move (4)
+        uint64_t pack(const TranspositionTable::Entry& e) {
+            return uint64_t(uint16_t(e.score + 32768)) |
+                (uint64_t(uint8_t(e.depth)) << 16) |
+                (uint64_t(e.bound & 3) << 24) |
+                (uint64_t(e.move & 15) << 26);
+        }
+
+        TranspositionTable::Entry unpack(uint64_t d) {
+            TranspositionTable::Entry e;
+            e.score = int(d & 0xFFFF) - 32768;
+            e.depth = int((d >> 16) & 0xFF);
+            e.bound = int((d >> 24) & 3);
+            e.move = int((d >> 26) & 15);
+            if (e.move == 15) e.move = -1;
+            return e;
+        }
+
+    }
+
+    TranspositionTable::TranspositionTable(size_t sizeMB) : slotCount(0), shift(64) {
+        resize(sizeMB);
+    }
+
+    void TranspositionTable::resize(size_t sizeMB) {
+        size_t wanted = std::max<size_t>(sizeMB, 1) * 1024 * 1024 / sizeof(Slot);
+        int bits = 0;
+        while ((size_t(2) << bits) <= wanted) bits++;
+        slotCount = size_t(1) << bits;
+        shift = 64 - bits;
+        slots.reset(new Slot[slotCount]);
+        clear();
+    }
+
+    void TranspositionTable::clear() {
+        for (size_t i = 0; i < slotCount; ++i) {
+            slots[i].check.store(0, std::memory_order_relaxed);
+            slots[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool TranspositionTable::probe(uint64_t key, Entry& out) const {
+        const Slot& slot = slots[index(key)];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key || data == 0)
+            return false;
+        out = unpack(data);
+        return true;
+    }
+
+    void TranspositionTable::store(uint64_t key, const Entry& entry) {
+        Slot& slot = slots[index(key)];
+        uint64_t data = pack(entry);
+        slot.data.store(data, std::memory_order_relaxed);
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+    }
+
+    ConnectFourSearch::ConnectFourSearch(size_t ttSizeMB, int threads)
+        : table(ttSizeMB), threads(threads < 1 ? 1 : threads), stopFlag(false), cancelled(false) {}
+
+    bool ConnectFourSearch::timeUp(const Worker& worker) {
+        if ((worker.nodes & 4095) == 0 && std::chrono::steady_clock::now() >= deadline)
+            stopFlag = true;
+        return stopFlag.load(std::memory_order_relaxed);
+    }
+
+    // Threats each side holds plus a small bonus for central stones
+    int ConnectFourSearch::evaluate(const ConnectFourBoard& board) const {
+        const uint64_t centerMask = uint64_t(0x3F) << (3 * ConnectFourBoard::HEIGHT);
+        int side = board.sideToMove();
+        uint64_t own = board.stones[side];
+        uint64_t opp = board.stones[side ^ 1];
+        uint64_t occ = board.occupied();
+        int threats = popcount(ConnectFourBoard::winningCells(own, occ)) -
+            popcount(ConnectFourBoard::winningCells(opp, occ));
+        int center = popcount(own & centerMask) - popcount(opp & centerMask);
+        return 8 * threats + 2 * center;
+    }
+
+    // TT move first, then columns that create the most new threats, ties broken center first
+    int ConnectFourSearch::orderMoves(const ConnectFourBoard& board, uint64_t candidates, int ttMove, int* out) const {
+        int keys[ConnectFourBoard::COLS];
+        int count = 0;
+        uint64_t own = board.stones[board.sideToMove()];
+        for (int col : columnOrder) {
+            uint64_t move = candidates & (ConnectFourBoard::BOARD_MASK & (uint64_t(0x3F) << (col * ConnectFourBoard::HEIGHT)));
+            if (!move) continue;
+            int key = (col == ttMove) ? 1000 : popcount(ConnectFourBoard::winningCells(own | move, board.occupied() | move));
+            int i = count++;
+            while (i > 0 && keys[i - 1] < key) {
+                keys[i] = keys[i - 1];
+                out[i] = out[i - 1];
+                --i;
+            }
+            keys[i] = key;
+            out[i] = col;
+        }
+        return count;
+    }
+
+    int ConnectFourSearch::negamax(Worker& worker, ConnectFourBoard& board, int depth, int alpha, int beta) {
+        worker.nodes++;
+        if (timeUp(worker)) return 0;
+
+        const int total = ConnectFourBoard::ROWS * ConnectFourBoard::COLS;
+        if (board.moves >= total) return 0;
+
+        // Immediate win for the side to move
+        uint64_t possible = board.possible();
+        int side = board.sideToMove();
+        if (ConnectFourBoard::winningCells(board.stones[side], board.occupied()) & possible)
+            return WIN_SCORE - (board.moves + 1);
+
+        // Only keep moves that don't hand the opponent a win
+        uint64_t oppWins = ConnectFourBoard::winningCells(board.stones[side ^ 1], board.occupied());
+        uint64_t forced = possible & oppWins;
+        if (forced) {
+            if (forced & (forced - 1))
+                return -(WIN_SCORE - (board.moves + 2));   // two threats, can't block both
+            possible = forced;
+        }
+        uint64_t candidates = possible & ~(oppWins >> 1);
+        if (!candidates)
+            return -(WIN_SCORE - (board.moves + 2));
+        if (board.moves + 2 >= total)
+            return 0;
+
+        if (depth <= 0) return evaluate(board);
+
+        int originalAlpha = alpha;
+        int ttMove = -1;
+        uint64_t key = board.key();
+        TranspositionTable::Entry entry;
+        worker.ttProbes++;
+        if (table.probe(key, entry)) {
+            worker.ttHits++;
+            ttMove = entry.move;
+            if (entry.depth >= depth) {
+                if (entry.bound == TranspositionTable::BOUND_EXACT) return entry.score;
+                if (entry.bound == TranspositionTable::BOUND_LOWER) alpha = std::max(alpha, entry.score);
+                if (entry.bound == TranspositionTable::BOUND_UPPER) beta = std::min(beta, entry.score);
+                if (alpha >= beta) return entry.score;
+            }
+        }
+
+        int moves[ConnectFourBoard::COLS];
+        int count = orderMoves(board, candidates, ttMove, moves);
+        int best = -WIN_SCORE;
+        int bestMove = moves[0];
+        for (int i = 0; i < count; ++i) {
+            board.play(moves[i]);
+            int score = -negamax(worker, board, depth - 1, -beta, -alpha);
+            board.undo(moves[i]);
+            if (stopFlag.load(std::memory_order_relaxed)) return 0;
+            if (score > best) {
+                best = score;
+                bestMove = moves[i];
+            }
+            if (best > alpha) alpha = best;
+            if (alpha >= beta) break;
+        }
+
+        entry.score = best;
+        entry.depth = std::min(depth, total - board.moves);   // anything past the last move is exact
+        entry.move = bestMove;
+        entry.bound = best <= originalAlpha ? TranspositionTable::BOUND_UPPER
+            : best >= beta ? TranspositionTable::BOUND_LOWER : TranspositionTable::BOUND_EXACT;
+        table.store(key, entry);
+        return best;
+    }
+
+    void ConnectFourSearch::iterate(Worker& worker, const ConnectFourBoard& start, int maxDepth) {
+        ConnectFourBoard board = start;
+        SearchResult& result = worker.result;
+        const int remaining = ConnectFourBoard::ROWS * ConnectFourBoard::COLS - board.moves;
+
+        // Helpers start one ply deeper on odd ids so the workers spread over two depths
+        for (int depth = 1 + (worker.id & 1); depth <= std::min(maxDepth, remaining); ++depth) {
+            int alpha = -WIN_SCORE, beta = WIN_SCORE;
+            int bestScore = -WIN_SCORE - 1, bestMove = -1;
+            int moves[ConnectFourBoard::COLS];
+            int count = orderMoves(board, board.possible(), result.move, moves);
+
+            // Helpers keep the best move first but rotate the rest of the root moves
+            if (worker.id > 0 && count > 2)
+                std::rotate(moves + 1, moves + 1 + (worker.id % (count - 1)), moves + count);
+
+            for (int i = 0; i < count; ++i) {
+                board.play(moves[i]);
+                int score = -negamax(worker, board, depth - 1, -beta, -alpha);
+                board.undo(moves[i]);
+                if (stopFlag.load(std::memory_order_relaxed)) break;
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestMove = moves[i];
+                }
+                alpha = std::max(alpha, bestScore);
+            }
+            if (stopFlag.load(std::memory_order_relaxed)) break;
+
+            result.move = bestMove;
+            result.score = bestScore;
+            result.depth = depth;
+            result.solved = depth >= remaining || std::abs(bestScore) > WIN_THRESHOLD;
+            if (result.solved) {
+                stopFlag = true;    // the other workers have nothing left to add
+                break;
+            }
+        }
+    }
+
+    SearchResult ConnectFourSearch::search(const ConnectFourBoard& start, int timeBudgetMs, int maxDepth) {
+        auto begin = std::chrono::steady_clock::now();
+        deadline = begin + std::chrono::milliseconds(timeBudgetMs);
+        // Clear before reading cancelled: a stop() racing with this either is seen
+        // here or sets stopFlag after it was cleared
+        stopFlag = false;
+        if (cancelled) stopFlag = true;
+
+        // Take an immediate win without searching
+        for (int col : columnOrder) {
+            if (start.canPlay(col) && start.isWinningMove(col)) {
+                SearchResult result;
+                result.move = col;
+                result.score = WIN_SCORE - (start.moves + 1);
+                result.solved = true;
+                result.depth = 1;
+                return result;
+            }
+        }
+
+        std::vector<Worker> workers(threads);
+        for (int i = 0; i < threads; ++i)
+            workers[i] = Worker{ i, 0, 0, 0, SearchResult() };
+
+        std::vector<std::thread> helpers;
+        for (int i = 1; i < threads; ++i)
+            helpers.emplace_back(&ConnectFourSearch::iterate, this, std::ref(workers[i]), std::cref(start), maxDepth);
+        iterate(workers[0], start, maxDepth);
+        stopFlag = true;
+        for (auto& t : helpers)
+            t.join();
+
+        // Prefer a solved result, then the deepest completed iteration, then the main worker
+        SearchResult result = workers[0].result;
+        for (const Worker& w : workers) {
+            const SearchResult& r = w.result;
+            if (r.move < 0) continue;
+            if ((r.solved && !result.solved) || (r.solved == result.solved && r.depth > result.depth))
+                result = r;
+        }
+        for (const Worker& w : workers) {
+            result.nodes += w.nodes;
+            result.ttProbes += w.ttProbes;
+            result.ttHits += w.ttHits;
+        }
+
+        if (result.move < 0) {
+            int moves[ConnectFourBoard::COLS];
+            if (orderMoves(start, start.possible(), -1, moves) > 0)
+                result.move = moves[0];
+        }
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        return result;
+    }
+
+}
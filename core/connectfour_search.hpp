@@ -0,0 +1,107 @@
+#ifndef CONNECTFOUR_SEARCH_HPP
+#define CONNECTFOUR_SEARCH_HPP
+
+#include "connectfour_core.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace core {
+
+    // Shared hash of searched positions. Each slot is two atomic words holding
+    // (key ^ data, data), so readers detect torn writes without taking a lock.
+    class TranspositionTable {
+    public:
+        enum Bound { BOUND_NONE = 0, BOUND_UPPER, BOUND_LOWER, BOUND_EXACT };
+
+        struct Entry {
+            int score;
+            int depth;
+            int bound;
+            int move;
+        };
+
+        explicit TranspositionTable(size_t sizeMB = 64);
+
+        void resize(size_t sizeMB);    // rounds down to a power-of-two slot count
+        void clear();
+        size_t sizeBytes() const { return slotCount * sizeof(Slot); }
+
+        bool probe(uint64_t key, Entry& out) const;
+        void store(uint64_t key, const Entry& entry);
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> check;
+            std::atomic<uint64_t> data;
+        };
+
+        size_t index(uint64_t key) const { return (key * 0x9E3779B97F4A7C15ull) >> shift; }
+
+        std::unique_ptr<Slot[]> slots;
+        size_t slotCount;
+        int shift;
+    };
+
+    struct SearchResult {
+        int move = -1;
+        int score = 0;          // from the side to move; |score| > WIN_THRESHOLD is a proven result
+        int depth = 0;          // deepest fully completed iteration
+        bool solved = false;    // depth covered the rest of the game
+        uint64_t nodes = 0;
+        uint64_t ttProbes = 0;
+        uint64_t ttHits = 0;
+        double seconds = 0.0;
+
+        double nodesPerSecond() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+        double ttHitRate() const { return ttProbes ? double(ttHits) / ttProbes : 0.0; }
+    };
+
+    // Iterative-deepening negamax with alpha-beta, center-first move ordering and a
+    // transposition table. Leaves beyond the horizon get a threat-count heuristic.
+    // With more than one thread the workers run Lazy SMP: every worker searches the
+    // whole tree and they share only the table, helpers offset by depth and root order.
+    class ConnectFourSearch {
+    public:
+        static const int WIN_SCORE = 1000;          // a win on move m scores WIN_SCORE - m
+        static const int WIN_THRESHOLD = WIN_SCORE - 64;
+
+        explicit ConnectFourSearch(size_t ttSizeMB = 64, int threads = 1);
+
+        SearchResult search(const ConnectFourBoard& board, int timeBudgetMs, int maxDepth = 64);
+        void clearTable() { table.clear(); }
+        void resizeTable(size_t sizeMB) { table.resize(sizeMB); }
+        void setThreads(int count) { threads = count < 1 ? 1 : count; }
+        int threadCount() const { return threads; }
+        // Aborts the running search and any started later, until resume(). A stop that
+        // lands before an async search has begun is not lost. Safe from any thread.
+        void stop() { cancelled = true; stopFlag = true; }
+        void resume() { cancelled = false; }
+
+    private:
+        struct Worker {
+            int id;
+            uint64_t nodes;
+            uint64_t ttProbes;
+            uint64_t ttHits;
+            SearchResult result;
+        };
+
+        void iterate(Worker& worker, const ConnectFourBoard& start, int maxDepth);
+        int negamax(Worker& worker, ConnectFourBoard& board, int depth, int alpha, int beta);
+        int evaluate(const ConnectFourBoard& board) const;
+        int orderMoves(const ConnectFourBoard& board, uint64_t candidates, int ttMove, int* out) const;
+        bool timeUp(const Worker& worker);
+
+        TranspositionTable table;
+        int threads;
+        std::chrono::steady_clock::time_point deadline;
+        std::atomic<bool> stopFlag;     // ends this search: time, a solved root or stop()
+        std::atomic<bool> cancelled;    // set by stop(), kept across searches
+    };
+
+}
+
+#endif // CONNECTFOUR_SEARCH_HPP
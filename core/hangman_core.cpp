@@ -0,0 +1,113 @@
+#include "hangman_core.hpp"
+#include "rng.hpp"
+#include <cctype>
+
+namespace core {
+
+    const std::vector<std::pair<std::string, std::string>> wordHintList = {
+        {"blizzard", "A storm that erases the world in white"},
+        {"eclipse", "When light hides behind a perfect shadow"},
+        {"avalanche", "A mountain’s sudden downward roar"},
+        {"tornado", "A spinning column with no mercy"},
+        {"mirage", "A lie made of heat and distance"},
+        {"horizon", "Where the sky pretends to touch the earth"},
+        {"nebula", "A cosmic cloud where stars are born"},
+        {"tempest", "A storm with a furious personality"},
+
+        {"chameleon", "A creature that refuses to choose one color"},
+        {"raven", "A dark bird with a darker reputation"},
+        {"lynx", "A wild cat with pointed ears of mystery"},
+        {"panther", "A silent shadow in the jungle"},
+        {"vulture", "A patient bird waiting for the last heartbeat"},
+        {"scorpion", "A tail that strikes before you notice"},
+        {"leviathan", "A legendary monster from the deep"},
+
+        {"phoenix", "A creature that dies only to rise again"},
+        {"chimera", "A beast made of impossible parts"},
+        {"griffin", "A guardian with a lion's body and eagle wings"},
+        {"minotaur", "A beast forever trapped in a maze"},
+        {"cyclops", "A giant with a single all-seeing eye"},
+
+        {"paradox", "A truth that contradicts itself"},
+        {"epiphany", "A sudden flash of understanding"},
+        {"enigma", "A mystery wrapped in confusion"},
+        {"serendipity", "A fortunate discovery by accident"},
+        {"labyrinth", "A place where the exit hides from you"},
+        {"obsidian", "Dark volcanic glass, sharp as betrayal"},
+        {"eloquence", "Speech that flows like poetry"},
+        {"empathy", "Feeling what another heart feels"},
+        {"zenith", "The highest point in the sky"},
+        {"harbinger", "A sign of things to come"},
+        {"nebulous", "Cloudy, unclear, hard to define"},
+
+        {"algorithm", "A sequence of steps computers obey"},
+        {"quantum", "The strange world of the very small"},
+        {"hologram", "Light pretending to be real"},
+        {"circuitry", "The nervous system of machines"},
+        {"fractal", "A pattern that repeats forever"},
+
+        {"silhouette", "A story told only in shadow"},
+        {"reverie", "A daydream that steals your attention"},
+        {"phantom", "Seen but never truly there"},
+        {"ascend", "To rise toward the impossible"},
+        {"eternal", "Something without beginning or end"},
+        {"solitude", "Alone, yet not always lonely"},
+        {"illusion", "When your eyes lie to your mind"}
+    };
+
+    HangmanGame::HangmanGame() {
+        reset(0);
+    }
+
+    void HangmanGame::reset(uint32_t seed) {
+        Rng rng(seed);
+        const auto& entry = wordHintList[rng.below(static_cast<uint32_t>(wordHintList.size()))];
+        word = entry.first;
+        hint = entry.second;
+
+        int wordLength = static_cast<int>(word.length());
+        dispWord.assign(wordLength * 2 - 1, ' '); // for spaces between _
+        for (int i = 0; i < wordLength; ++i) {
+            dispWord[i * 2] = '_';
+        }
+
+        guessedLetters.clear();
+        found = 0;
+        tries = MAX_TRIES;
+        gameOver = false;
+        won = false;
+    }
+
+    bool HangmanGame::apply(char guess) {
+        if (gameOver || !isalpha(static_cast<unsigned char>(guess)))
+            return false;
+
+        guess = static_cast<char>(tolower(static_cast<unsigned char>(guess)));
+        if (guessedLetters.find(guess) != std::string::npos)
+            return false;
+
+        guessedLetters += guess;
+        int wordLength = static_cast<int>(word.length());
+        bool correct = false;
+        for (int i = 0; i < wordLength; ++i) {
+            if (word[i] == guess && dispWord[i * 2] == '_') {
+                dispWord[i * 2] = guess;
+                found++;
+                correct = true;
+            }
+        }
+        if (!correct) {
+            tries--;
+        }
+
+        if (found == wordLength) {
+            gameOver = true;
+            won = true;
+        }
+        else if (tries == 0) {
+            gameOver = true;
+        }
+        return true;
+    }
+
+}
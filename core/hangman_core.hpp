@@ -0,0 +1,35 @@
+#ifndef HANGMAN_CORE_HPP
+#define HANGMAN_CORE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define MAX_TRIES 6
+
+namespace core {
+
+    // Word and hint pairs
+    extern const std::vector<std::pair<std::string, std::string>> wordHintList;
+
+    class HangmanGame {
+    public:
+        HangmanGame();
+
+        void reset(uint32_t seed);
+        bool apply(char guess);     // false if the letter was already guessed or the round is over
+        void step(float) {}
+
+        std::string word;
+        std::string hint;
+        std::string dispWord;       // letters separated by spaces, '_' for unknown ones
+        std::string guessedLetters;
+        int found;
+        int tries;
+        bool gameOver;
+        bool won;
+    };
+
+}
+
+#endif // HANGMAN_CORE_HPP
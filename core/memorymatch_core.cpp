@@ -0,0 +1,66 @@
+#include "memorymatch_core.hpp"
+#include <algorithm>
+
+namespace core {
+
+    MemoryMatchGame::MemoryMatchGame(int rows, int cols) {
+        reset(rows, cols, 0);
+    }
+
+    void MemoryMatchGame::reset(int newRows, int newCols, uint32_t seed) {
+        rows = std::max(2, std::min(newRows, MAX_SIDE));
+        cols = std::max(2, std::min(newCols, MAX_SIDE));
+        totalCards = rows * cols / 2 * 2;
+        cards.face.assign(totalCards, 0);
+        cards.state.assign(totalCards, FACE_DOWN);
+        reset(seed);
+    }
+
+    void MemoryMatchGame::reset(uint32_t seed) {
+        for (int i = 0; i < totalCards; i += 2) {
+            cards.face[i] = cards.face[i + 1] = static_cast<uint16_t>(i / 2);
+        }
+        Rng rng(seed);
+        std::shuffle(cards.face.begin(), cards.face.end(), rng);
+        std::fill(cards.state.begin(), cards.state.end(), FACE_DOWN);
+        choiceCount = 0;
+        pairsLeft = totalCards / 2;
+        score = 0;
+        isPaused = false;
+        pauseTimer = 0.f;
+        gameOver = false;
+    }
+
+    bool MemoryMatchGame::apply(int card) {
+        if (gameOver || card < 0 || card >= totalCards || isFaceUp(card) || choiceCount >= 2)
+            return false;
+
+        cards.state[card] = CHOSEN;
+        choice[choiceCount++] = card;
+        if (choiceCount == 2) {
+            isPaused = true;
+            pauseTimer = 0.f;
+        }
+        return true;
+    }
+
+    void MemoryMatchGame::step(float dt) {
+        if (!isPaused) return;
+
+        pauseTimer += dt;
+        if (pauseTimer <= FLIP_BACK_DELAY) return;
+
+        bool pair = cards.face[choice[0]] == cards.face[choice[1]];
+        cards.state[choice[0]] = cards.state[choice[1]] = pair ? MATCHED : FACE_DOWN;
+        if (pair) {
+            score++;
+            pairsLeft--;
+        }
+        choiceCount = 0;
+        isPaused = false;
+
+        if (pairsLeft == 0)
+            gameOver = true;
+    }
+
+}
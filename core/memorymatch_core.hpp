@@ -0,0 +1,52 @@
+#ifndef MEMORYMATCH_CORE_HPP
+#define MEMORYMATCH_CORE_HPP
+
+#include "rng.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace core {
+
+    class MemoryMatchGame {
+    public:
+        static constexpr float FLIP_BACK_DELAY = 1.f;   // seconds a mismatched pair stays face up
+        static constexpr int MAX_SIDE = 32;
+
+        enum CardState : uint8_t { FACE_DOWN, CHOSEN, MATCHED };
+
+        // Card state as one array per field, indexed by card number (row-major).
+        // Faces fit 16 bits: a 32x32 grid holds 512 pairs.
+        struct Cards {
+            std::vector<uint16_t> face;     // pair id; both cards of a pair share it
+            std::vector<uint8_t> state;     // CardState
+        };
+
+        // Sides are clamped to [2, MAX_SIDE]; with an odd card count the last cell stays empty
+        explicit MemoryMatchGame(int rows = 4, int cols = 4);
+
+        void reset(uint32_t seed);
+        void reset(int rows, int cols, uint32_t seed);
+        bool apply(int card);       // flips a card face up, false if it cannot be chosen now
+        void step(float dt);        // resolves the chosen pair once the delay has passed
+
+        bool isFaceUp(int card) const { return cards.state[card] != FACE_DOWN; }
+        int face(int card) const { return cards.face[card]; }
+        // Seconds until step() resolves the chosen pair; negative while waiting on input
+        float timeUntilStep() const { return isPaused ? FLIP_BACK_DELAY - pauseTimer : -1.f; }
+
+        int rows;
+        int cols;
+        int totalCards;
+        Cards cards;
+        int choice[2];
+        int choiceCount;
+        int pairsLeft;              // the round ends when this reaches zero
+        int score;
+        bool isPaused;
+        float pauseTimer;
+        bool gameOver;
+    };
+
+}
+
+#endif // MEMORYMATCH_CORE_HPP
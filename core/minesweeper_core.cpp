@@ -0,0 +1,339 @@
+#include "minesweeper_core.hpp"
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MINESWEEPER_SSE2 1
+#endif
+
+namespace core {
+
+    MinesweeperGame::MinesweeperGame(int rows, int cols, int numMines) : rows(0), cols(0), numMines(0) {
+        reset(rows, cols, numMines, 0);
+    }
+
+    void MinesweeperGame::reset(int newRows, int newCols, int newMines, uint32_t seed) {
+        rows = std::max(1, std::min(newRows, MAX_SIDE));
+        cols = std::max(1, std::min(newCols, MAX_SIDE));
+        numMines = static_cast<int>(std::max<int64_t>(0, std::min<int64_t>(newMines, int64_t(rows) * cols)));
+        tiles.assign(static_cast<size_t>(rows) * cols, MinesweeperTile{});
+        tiles.shrink_to_fit();
+        reset(seed);
+    }
+
+    void MinesweeperGame::reset(uint32_t seed) {
+        rng = Rng(seed);
+        std::fill(tiles.begin(), tiles.end(), MinesweeperTile{});
+
+        placeMines();
+        calculateAdjacency();
+
+        hiddenSafe = rows * cols - numMines;
+        firstRevealDone = false;
+        gameOver = false;
+        won = false;
+        timerRunning = true;
+        elapsed = 0.f;
+    }
+
+    void MinesweeperGame::load(const MinesweeperLayout& layout) {
+        rows = layout.rows;
+        cols = layout.cols;
+        numMines = layout.mines;
+        tiles = layout.tiles;
+        rng = Rng(layout.seed);
+
+        hiddenSafe = rows * cols - numMines;
+        firstRevealDone = false;
+        gameOver = false;
+        won = false;
+        timerRunning = true;
+        elapsed = 0.f;
+    }
+
+    MinesweeperLayout MinesweeperGame::layout() const {
+        MinesweeperLayout out;
+        out.rows = rows;
+        out.cols = cols;
+        out.mines = numMines;
+        out.tiles.resize(tiles.size());
+        const uint8_t KEEP = MinesweeperTile::MINE | MinesweeperTile::ADJACENT_MASK;
+        for (size_t i = 0; i < tiles.size(); ++i)
+            out.tiles[i].bits = tiles[i].bits & KEEP;
+        return out;
+    }
+
+    void MinesweeperGame::step(float dt) {
+        if (timerRunning)
+            elapsed += dt;
+    }
+
+    bool MinesweeperGame::apply(Action action, int r, int c) {
+        if (gameOver || !inside(r, c))
+            return false;
+
+        MinesweeperTile& t = tile(r, c);
+        if (action == FLAG) {
+            if (t.revealed()) return false;
+            if (t.flagged()) t.clear(MinesweeperTile::FLAGGED);
+            else t.set(MinesweeperTile::FLAGGED);
+            return true;
+        }
+
+        if (t.flagged()) return false;
+
+        if (!firstRevealDone) {
+            firstRevealDone = true;
+            clearAround(r, c);
+        }
+
+        if (t.mine()) {
+            // ---- LOSS ----
+            gameOver = true;
+            timerRunning = false;
+            for (MinesweeperTile& m : tiles)
+                if (m.mine())
+                    m.set(MinesweeperTile::REVEALED);
+        }
+        else {
+            reveal(r, c);
+            if (hiddenSafe == 0) {
+                // ---- WIN ----
+                gameOver = true;
+                won = true;
+                timerRunning = false;
+            }
+        }
+        return true;
+    }
+
+    // Floyd's sampling, the set form of a partial Fisher-Yates shuffle: for each of
+    // the last k indices j, pick a random index up to j, or j itself when that one is
+    // taken. The tiles are the set, so the cost is one draw per mine whatever the
+    // density and nothing is allocated. Past half the board it is cheaper to fill
+    // every tile and pick the safe ones instead.
+    void MinesweeperGame::placeMines() {
+        const uint32_t count = static_cast<uint32_t>(tiles.size());
+        const bool pickSafe = static_cast<uint32_t>(numMines) > count / 2;
+        const uint32_t picks = pickSafe ? count - numMines : numMines;
+        if (pickSafe)
+            for (MinesweeperTile& t : tiles)
+                t.set(MinesweeperTile::MINE);
+
+        for (uint32_t j = count - picks; j < count; ++j) {
+            uint32_t t = rng.below(j + 1);
+            if (tiles[t].mine() != pickSafe) t = j;
+            if (pickSafe) tiles[t].clear(MinesweeperTile::MINE);
+            else tiles[t].set(MinesweeperTile::MINE);
+        }
+    }
+
+    namespace {
+
+        const uint8_t MINE_BIT = MinesweeperTile::MINE;
+
+        // sums[c] = mine bits of column c in three rows. Each mine adds MINE_BIT (16),
+        // so a full 3x3 block sums to 144 and still fits in a byte.
+        void columnSums(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* sums, int n) {
+            int c = 0;
+#if defined(__AVX2__)
+            const __m256i mask = _mm256_set1_epi8(static_cast<char>(MINE_BIT));
+            for (; c + 32 <= n; c += 32) {
+                __m256i a = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(above + c)), mask);
+                __m256i b = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + c)), mask);
+                __m256i d = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(below + c)), mask);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + c), _mm256_add_epi8(_mm256_add_epi8(a, b), d));
+            }
+#elif defined(MINESWEEPER_SSE2)
+            const __m128i mask = _mm_set1_epi8(static_cast<char>(MINE_BIT));
+            for (; c + 16 <= n; c += 16) {
+                __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(above + c)), mask);
+                __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + c)), mask);
+                __m128i d = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(below + c)), mask);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + c), _mm_add_epi8(_mm_add_epi8(a, b), d));
+            }
+#endif
+            for (; c < n; ++c)
+                sums[c] = static_cast<uint8_t>((above[c] & MINE_BIT) + (row[c] & MINE_BIT) + (below[c] & MINE_BIT));
+        }
+
+        // padded holds the column sums with a zero column each side, so tile c's 3x3
+        // sum is padded[c] + padded[c + 1] + padded[c + 2]. Mines keep a count of zero.
+        void writeCounts(const uint8_t* padded, uint8_t* row, int n) {
+            int c = 0;
+#if defined(__AVX2__)
+            const __m256i mask = _mm256_set1_epi8(static_cast<char>(MINE_BIT));
+            const __m256i low = _mm256_set1_epi8(MinesweeperTile::ADJACENT_MASK);
+            for (; c + 32 <= n; c += 32) {
+                __m256i sum = _mm256_add_epi8(_mm256_add_epi8(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(padded + c)),
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(padded + c + 1))),
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(padded + c + 2)));
+                __m256i count = _mm256_and_si256(_mm256_srli_epi16(sum, 4), low);
+                __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + c));
+                __m256i isMine = _mm256_cmpeq_epi8(_mm256_and_si256(bits, mask), mask);
+                count = _mm256_andnot_si256(isMine, count);
+                bits = _mm256_or_si256(_mm256_andnot_si256(low, bits), count);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + c), bits);
+            }
+#elif defined(MINESWEEPER_SSE2)
+            const __m128i mask = _mm_set1_epi8(static_cast<char>(MINE_BIT));
+            const __m128i low = _mm_set1_epi8(MinesweeperTile::ADJACENT_MASK);
+            for (; c + 16 <= n; c += 16) {
+                __m128i sum = _mm_add_epi8(_mm_add_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded + c)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded + c + 1))),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded + c + 2)));
+                __m128i count = _mm_and_si128(_mm_srli_epi16(sum, 4), low);
+                __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + c));
+                __m128i isMine = _mm_cmpeq_epi8(_mm_and_si128(bits, mask), mask);
+                count = _mm_andnot_si128(isMine, count);
+                bits = _mm_or_si128(_mm_andnot_si128(low, bits), count);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + c), bits);
+            }
+#endif
+            for (; c < n; ++c) {
+                int count = (padded[c] + padded[c + 1] + padded[c + 2]) >> 4;
+                if (row[c] & MINE_BIT) count = 0;
+                row[c] = static_cast<uint8_t>((row[c] & ~MinesweeperTile::ADJACENT_MASK) | count);
+            }
+        }
+
+    }
+
+    // Adjacent counts as a 3x3 box sum, separated into a vertical pass (three rows
+    // into one row of column sums) and a horizontal one (three neighbouring column
+    // sums). Rows off the board read as a row of zeros, and the column sums carry a
+    // zero column each side, so neither pass checks bounds. Both run 16 or 32 tiles
+    // at a time with SSE2 or AVX2, and a plain loop finishes each row.
+    void MinesweeperGame::calculateAdjacency() {
+        std::vector<uint8_t> zeros(cols, 0);
+        std::vector<uint8_t> padded(cols + 2, 0);
+        uint8_t* data = reinterpret_cast<uint8_t*>(tiles.data());
+        for (int r = 0; r < rows; ++r) {
+            uint8_t* row = data + static_cast<size_t>(r) * cols;
+            const uint8_t* above = r > 0 ? row - cols : zeros.data();
+            const uint8_t* below = r + 1 < rows ? row + cols : zeros.data();
+            columnSums(above, row, below, padded.data() + 1, cols);
+            writeCounts(padded.data(), row, cols);
+        }
+    }
+
+    // Adjacent count of one tile from its neighbours; mines keep a count of zero
+    void MinesweeperGame::recount(int r, int c) {
+        MinesweeperTile& t = tile(r, c);
+        int count = 0;
+        if (!t.mine())
+            for (int nr = std::max(0, r - 1); nr <= std::min(rows - 1, r + 1); ++nr)
+                for (int nc = std::max(0, c - 1); nc <= std::min(cols - 1, c + 1); ++nc)
+                    count += tile(nr, nc).mine();
+        t.setAdjacentMines(count);
+    }
+
+    // First-click safety: moves the mines in the 3x3 block around (r, c) to free
+    // tiles outside it, so the click opens an area. When the board is too full for
+    // that, only the clicked tile is cleared. Each moved mine goes to the first free
+    // tile at or after a random position, which stays bounded on dense boards.
+    void MinesweeperGame::clearAround(int r, int c) {
+        int r0 = std::max(0, r - 1), r1 = std::min(rows - 1, r + 1);
+        int c0 = std::max(0, c - 1), c1 = std::min(cols - 1, c + 1);
+        int inside = 0;
+        for (int nr = r0; nr <= r1; ++nr)
+            for (int nc = c0; nc <= c1; ++nc)
+                inside += tile(nr, nc).mine();
+        if (inside == 0) return;
+
+        int area = (r1 - r0 + 1) * (c1 - c0 + 1);
+        bool wholeBlock = rows * cols - area >= numMines;
+        if (!wholeBlock) {
+            if (!tile(r, c).mine() || numMines == rows * cols) return;
+            r0 = r1 = r;
+            c0 = c1 = c;
+        }
+        auto blocked = [&](int nr, int nc) { return nr >= r0 && nr <= r1 && nc >= c0 && nc <= c1; };
+
+        size_t count = tiles.size();
+        for (int nr = r0; nr <= r1; ++nr)
+            for (int nc = c0; nc <= c1; ++nc) {
+                if (!tile(nr, nc).mine()) continue;
+                size_t i = rng.below(static_cast<uint32_t>(count));
+                while (tiles[i].mine() || blocked(static_cast<int>(i / cols), static_cast<int>(i % cols)))
+                    i = i + 1 == count ? 0 : i + 1;
+                tile(nr, nc).clear(MinesweeperTile::MINE);
+                tiles[i].set(MinesweeperTile::MINE);
+
+                int mr = static_cast<int>(i / cols), mc = static_cast<int>(i % cols);
+                for (int ar = std::max(0, mr - 1); ar <= std::min(rows - 1, mr + 1); ++ar)
+                    for (int ac = std::max(0, mc - 1); ac <= std::min(cols - 1, mc + 1); ++ac)
+                        recount(ar, ac);
+            }
+        for (int nr = std::max(0, r0 - 1); nr <= std::min(rows - 1, r1 + 1); ++nr)
+            for (int nc = std::max(0, c0 - 1); nc <= std::min(cols - 1, c1 + 1); ++nc)
+                recount(nr, nc);
+    }
+
+    // Scanline flood fill. Each queued span is a run of blank tiles in one row that
+    // has just been revealed; processing it widens the run along its row, then
+    // reveals the rows above and below across the run plus one tile each side
+    // (the diagonals), queueing any blank runs found there. Tiles are marked as
+    // they are revealed, so none is queued twice, and the queue is reused between clicks.
+    // Flood fills never reach mines, since every neighbour of a blank tile is safe.
+    void MinesweeperGame::reveal(int r, int c) {
+        MinesweeperTile& start = tile(r, c);
+        if (start.revealed()) return;
+        start.set(MinesweeperTile::REVEALED);
+        hiddenSafe--;
+        if (start.adjacentMines() != 0) return;
+
+        const uint8_t STOP = MinesweeperTile::REVEALED | MinesweeperTile::FLAGGED;
+        revealQueue.clear();
+        revealQueue.push_back(Span{ r, c, c });
+        while (!revealQueue.empty()) {
+            Span span = revealQueue.back();
+            revealQueue.pop_back();
+
+            // Widen along the row; a number ends the run but is revealed too
+            MinesweeperTile* row = &tile(span.row, 0);
+            int left = span.left, right = span.right;
+            while (left > 0 && !(row[left - 1].bits & STOP)) {
+                row[--left].set(MinesweeperTile::REVEALED);
+                hiddenSafe--;
+                if (row[left].adjacentMines() != 0) break;
+            }
+            if (left < span.left && row[left].adjacentMines() != 0) ++left;
+            while (right + 1 < cols && !(row[right + 1].bits & STOP)) {
+                row[++right].set(MinesweeperTile::REVEALED);
+                hiddenSafe--;
+                if (row[right].adjacentMines() != 0) break;
+            }
+            if (right > span.right && row[right].adjacentMines() != 0) --right;
+
+            int c0 = left > 0 ? left - 1 : 0;
+            int c1 = right + 1 < cols ? right + 1 : right;
+            for (int nr = span.row - 1; nr <= span.row + 1; nr += 2) {
+                if (nr < 0 || nr >= rows) continue;
+                MinesweeperTile* next = &tile(nr, 0);
+                int runStart = -1;
+                for (int nc = c0; nc <= c1; ++nc) {
+                    MinesweeperTile& t = next[nc];
+                    bool blank = false;
+                    if (!(t.bits & STOP)) {
+                        t.set(MinesweeperTile::REVEALED);
+                        hiddenSafe--;
+                        blank = t.adjacentMines() == 0;
+                    }
+                    if (blank && runStart < 0) runStart = nc;
+                    if (!blank && runStart >= 0) {
+                        revealQueue.push_back(Span{ nr, runStart, nc - 1 });
+                        runStart = -1;
+                    }
+                }
+                if (runStart >= 0)
+                    revealQueue.push_back(Span{ nr, runStart, c1 });
+            }
+        }
+    }
+
+}
@@ -0,0 +1,105 @@
+#ifndef MINESWEEPER_CORE_HPP
+#define MINESWEEPER_CORE_HPP
+
+#include "rng.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    // One byte per tile: the low four bits hold the adjacent mine count (0-8),
+    // the next three the mine, revealed and flagged states
+    struct MinesweeperTile {
+        static constexpr uint8_t ADJACENT_MASK = 0x0F;
+        static constexpr uint8_t MINE = 0x10;
+        static constexpr uint8_t REVEALED = 0x20;
+        static constexpr uint8_t FLAGGED = 0x40;
+
+        uint8_t bits = 0;
+
+        bool mine() const { return (bits & MINE) != 0; }
+        bool revealed() const { return (bits & REVEALED) != 0; }
+        bool flagged() const { return (bits & FLAGGED) != 0; }
+        int adjacentMines() const { return bits & ADJACENT_MASK; }
+
+        void set(uint8_t flag) { bits |= flag; }
+        void clear(uint8_t flag) { bits &= static_cast<uint8_t>(~flag); }
+        void setAdjacentMines(int count) { bits = static_cast<uint8_t>((bits & ~ADJACENT_MASK) | count); }
+    };
+    static_assert(sizeof(MinesweeperTile) == 1, "tiles are packed one per byte");
+
+    // A finished board before play: mine bits and adjacent counts only. startRow/startCol,
+    // when set, is a tile to open first, blank unless the board is nearly all mines;
+    // with noGuess set, a player who starts there can clear the board by deduction alone.
+    struct MinesweeperLayout {
+        int rows = 0;
+        int cols = 0;
+        int mines = 0;
+        int startRow = -1;
+        int startCol = -1;
+        bool noGuess = false;
+        uint32_t seed = 0;          // seeds the game's own rng after load()
+        std::vector<MinesweeperTile> tiles;
+    };
+
+    class MinesweeperGame {
+    public:
+        enum Action { REVEAL, FLAG };
+
+        static constexpr int MAX_SIDE = 10000;
+
+        MinesweeperGame(int rows = 9, int cols = 9, int numMines = 10);
+
+        void reset(uint32_t seed);
+        // New dimensions: sides are clamped to [1, MAX_SIDE], mines to the tile count
+        void reset(int rows, int cols, int numMines, uint32_t seed);
+        // Plays a pre-built board; dimensions come from the layout
+        void load(const MinesweeperLayout& layout);
+        // The current board with play state stripped, start tile unset
+        MinesweeperLayout layout() const;
+        bool apply(Action action, int r, int c);
+        void step(float dt);        // runs the game clock while the round is live
+
+        int safeTilesLeft() const { return hiddenSafe; }    // unrevealed tiles without a mine
+        // False until the first reveal of the round. That reveal never hits a mine:
+        // mines in and around the clicked tile are moved elsewhere first.
+        bool started() const { return firstRevealDone; }
+        int elapsedSeconds() const { return static_cast<int>(elapsed); }
+        // Seconds until elapsedSeconds() next changes; negative while the clock is stopped
+        float timeUntilNextSecond() const { return timerRunning ? elapsedSeconds() + 1 - elapsed : -1.f; }
+
+        bool inside(int r, int c) const { return r >= 0 && r < rows && c >= 0 && c < cols; }
+        // Tiles are stored row-major in one array, so walking a row is a linear scan
+        const MinesweeperTile& at(int r, int c) const { return tiles[static_cast<size_t>(r) * cols + c]; }
+        const MinesweeperTile* data() const { return tiles.data(); }
+
+        int rows;
+        int cols;
+        int numMines;
+        bool gameOver;
+        bool won;
+        bool timerRunning;
+        float elapsed;
+
+    private:
+        MinesweeperTile& tile(int r, int c) { return tiles[static_cast<size_t>(r) * cols + c]; }
+        void placeMines();
+        void calculateAdjacency();
+        void recount(int r, int c);
+        void clearAround(int r, int c);
+        void reveal(int r, int c);
+
+        std::vector<MinesweeperTile> tiles;
+        int hiddenSafe;                 // the round is won when this reaches zero
+        bool firstRevealDone;
+        struct Span {
+            int row, left, right;
+        };
+        std::vector<Span> revealQueue;  // flood fill work list, kept between clicks
+        Rng rng;
+    };
+
+}
+
+#endif // MINESWEEPER_CORE_HPP
@@ -0,0 +1,151 @@
+#include "minesweeper_generator.hpp"
+#include "minesweeper_solver.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace core {
+
+    namespace {
+
+        // Lets the solver play from the start tile; any guess or stall fails the board
+        bool solvesWithoutGuessing(MinesweeperGame& game, MinesweeperSolver& solver, int r, int c) {
+            solver.reset(game);
+            solver.observe(game, r, c);
+            while (!game.gameOver) {
+                MinesweeperSolver::Move move = solver.next(game);
+                if (move.reason == MinesweeperSolver::GUESS || move.reason == MinesweeperSolver::NONE)
+                    return false;
+                if (move.reason == MinesweeperSolver::MINE) {
+                    game.apply(MinesweeperGame::FLAG, move.row, move.col);
+                    continue;
+                }
+                game.apply(MinesweeperGame::REVEAL, move.row, move.col);
+                solver.observe(game, move.row, move.col);
+            }
+            return game.won;
+        }
+
+    }
+
+    MinesweeperLayout generateMinesweeperBoard(const MinesweeperBoardSpec& spec, uint64_t seed,
+        int maxAttempts, int* attempts) {
+        Rng rng(seed);
+        MinesweeperGame game(spec.rows, spec.cols, spec.mines);
+        MinesweeperSolver solver;
+        MinesweeperLayout board;
+        int tries = 0;
+        for (;;) {
+            tries++;
+            game.reset(static_cast<uint32_t>(rng.next()));
+            int r = static_cast<int>(rng.below(game.rows));
+            int c = static_cast<int>(rng.below(game.cols));
+            game.apply(MinesweeperGame::REVEAL, r, c);
+
+            board = game.layout();
+            board.startRow = r;
+            board.startCol = c;
+            board.seed = static_cast<uint32_t>(rng.next());
+            if (!spec.noGuess || game.gameOver) break;
+            if (solvesWithoutGuessing(game, solver, r, c)) {
+                board.noGuess = true;
+                break;
+            }
+            if (tries >= maxAttempts) break;
+        }
+        if (attempts) *attempts = tries;
+        return board;
+    }
+
+    MinesweeperBoardPool::MinesweeperBoardPool(int threads, size_t boardsPerSpec)
+        : boardsPerSpec(std::max<size_t>(1, boardsPerSpec)) {
+        std::random_device device;
+        seeds = (static_cast<uint64_t>(device()) << 32) ^ device() ^
+            static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+        if (threads <= 0)
+            threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+        for (int i = 0; i < threads; ++i)
+            workers.emplace_back(&MinesweeperBoardPool::work, this);
+    }
+
+    // A worker part-way through a board finishes it first
+    MinesweeperBoardPool::~MinesweeperBoardPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers)
+            t.join();
+    }
+
+    bool MinesweeperBoardPool::take(const MinesweeperBoardSpec& spec, MinesweeperLayout& board) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Stock& stock = stockFor(spec);
+            if (!stock.boards.empty()) {
+                board = std::move(stock.boards.front());
+                stock.boards.pop_front();
+                wake.notify_one();
+                return true;
+            }
+        }
+        wake.notify_all();
+        return false;
+    }
+
+    void MinesweeperBoardPool::prepare(const MinesweeperBoardSpec& spec) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stockFor(spec);
+        }
+        wake.notify_all();
+    }
+
+    size_t MinesweeperBoardPool::ready(const MinesweeperBoardSpec& spec) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<Stock>& stock : stocks)
+            if (stock->spec == spec)
+                return stock->boards.size();
+        return 0;
+    }
+
+    MinesweeperBoardPool::Stock& MinesweeperBoardPool::stockFor(const MinesweeperBoardSpec& spec) {
+        for (std::unique_ptr<Stock>& stock : stocks)
+            if (stock->spec == spec)
+                return *stock;
+        stocks.push_back(std::make_unique<Stock>());
+        stocks.back()->spec = spec;
+        return *stocks.back();
+    }
+
+    // The spec furthest below its target, counting boards still being built
+    MinesweeperBoardPool::Stock* MinesweeperBoardPool::neediest() {
+        Stock* best = nullptr;
+        for (std::unique_ptr<Stock>& stock : stocks) {
+            size_t have = stock->boards.size() + stock->building;
+            if (have < boardsPerSpec && (!best || have < best->boards.size() + best->building))
+                best = stock.get();
+        }
+        return best;
+    }
+
+    void MinesweeperBoardPool::work() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || neediest() != nullptr; });
+            if (stopping) return;
+
+            Stock* stock = neediest();
+            stock->building++;
+            MinesweeperBoardSpec spec = stock->spec;
+            lock.unlock();
+            MinesweeperLayout board = generateMinesweeperBoard(spec, newSeed());
+            lock.lock();
+            stock->building--;
+            stock->boards.push_back(std::move(board));
+        }
+    }
+
+}
@@ -0,0 +1,77 @@
+#ifndef MINESWEEPER_GENERATOR_HPP
+#define MINESWEEPER_GENERATOR_HPP
+
+#include "minesweeper_core.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+    struct MinesweeperBoardSpec {
+        int rows;
+        int cols;
+        int mines;
+        bool noGuess;       // only boards the solver clears from the start tile without guessing
+
+        bool operator==(const MinesweeperBoardSpec& o) const {
+            return rows == o.rows && cols == o.cols && mines == o.mines && noGuess == o.noGuess;
+        }
+    };
+
+    // Builds one board from a seed: mines are placed, a random start tile is cleared
+    // by the first-click rule, and for no-guess specs the solver plays it from there.
+    // Candidates that need a guess are thrown away and the next seed tried; after
+    // maxAttempts the last candidate is returned with noGuess false, so dense boards
+    // still get a first-click-safe layout.
+    MinesweeperLayout generateMinesweeperBoard(const MinesweeperBoardSpec& spec, uint64_t seed,
+        int maxAttempts = 2000, int* attempts = nullptr);
+
+    // Worker threads that keep a few finished boards ready for every spec asked for,
+    // so starting a round only pops a queue. Specs are added by the first take() or
+    // prepare() that names them. The destructor stops and joins the workers.
+    class MinesweeperBoardPool {
+    public:
+        // threads <= 0 uses every core but one
+        explicit MinesweeperBoardPool(int threads = 0, size_t boardsPerSpec = 4);
+        ~MinesweeperBoardPool();
+        MinesweeperBoardPool(const MinesweeperBoardPool&) = delete;
+        MinesweeperBoardPool& operator=(const MinesweeperBoardPool&) = delete;
+
+        // Pops a ready board into board. False when the queue is empty; the workers are
+        // then building one, so ask again later. Never generates on the calling thread.
+        bool take(const MinesweeperBoardSpec& spec, MinesweeperLayout& board);
+        // Starts filling the queue for spec without taking from it
+        void prepare(const MinesweeperBoardSpec& spec);
+        size_t ready(const MinesweeperBoardSpec& spec) const;
+
+    private:
+        struct Stock {
+            MinesweeperBoardSpec spec;
+            std::deque<MinesweeperLayout> boards;
+            size_t building = 0;
+        };
+
+        Stock& stockFor(const MinesweeperBoardSpec& spec);     // caller holds mutex
+        Stock* neediest();                                      // caller holds mutex
+        void work();
+        uint64_t newSeed() { return seeds.fetch_add(0x9E3779B97F4A7C15ull); }
+
+        const size_t boardsPerSpec;
+        std::atomic<uint64_t> seeds;    // every board draws a fresh one, so no two repeat
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<std::unique_ptr<Stock>> stocks;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+    };
+
+}
+
+#endif // MINESWEEPER_GENERATOR_HPP
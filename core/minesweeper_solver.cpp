@@ -0,0 +1,619 @@
+#include "minesweeper_solver.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+
+    namespace {
+
+        double logChoose(int n, int k) {
+            if (k < 0 || k > n) return -INFINITY;
+            return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+        }
+
+        // Full convolution of two mine-count distributions
+        std::vector<double> convolve(const std::vector<double>& a, const std::vector<double>& b) {
+            std::vector<double> out(a.size() + b.size() - 1, 0.0);
+            for (size_t i = 0; i < a.size(); ++i)
+                if (a[i] != 0.0)
+                    for (size_t j = 0; j < b.size(); ++j)
+                        out[i + j] += a[i] * b[j];
+            return out;
+        }
+
+        struct Enumeration {
+            const std::vector<std::vector<int>>* cellConstraints;
+            std::vector<int> need;      // mines each constraint still needs
+            std::vector<int> left;      // unassigned tiles each constraint still has
+            std::vector<uint8_t> value;
+            std::vector<double>* solutions;
+            std::vector<double>* cellMines;
+            int cells;
+            int mines = 0;
+            long steps = 0;
+            long budget;
+
+            bool assign(int cell, int v) {
+                bool ok = true;
+                for (int c : (*cellConstraints)[cell]) {
+                    need[c] -= v;
+                    left[c] -= 1;
+                    if (need[c] < 0 || need[c] > left[c]) ok = false;
+                }
+                return ok;
+            }
+
+            void undo(int cell, int v) {
+                for (int c : (*cellConstraints)[cell]) {
+                    need[c] += v;
+                    left[c] += 1;
+                }
+            }
+
+            // false once the step budget runs out; recording a layout costs a step per cell
+            bool run(int cell) {
+                if (++steps > budget) return false;
+                if (cell == cells) {
+                    steps += cells;
+                    (*solutions)[mines] += 1.0;
+                    double* row = &(*cellMines)[static_cast<size_t>(mines) * cells];
+                    for (int i = 0; i < cells; ++i)
+                        row[i] += value[i];
+                    return true;
+                }
+                for (int v = 0; v <= 1; ++v) {
+                    value[cell] = static_cast<uint8_t>(v);
+                    mines += v;
+                    bool ok = assign(cell, v);
+                    bool more = !ok || run(cell + 1);
+                    undo(cell, v);
+                    mines -= v;
+                    if (!more) return false;
+                }
+                value[cell] = 0;
+                return true;
+            }
+        };
+
+        // Groups larger than this are estimated locally instead of enumerated
+        const int MAX_ENUMERATED_CELLS = 128;
+
+        const uint8_t IN_WORK = 1;
+        const uint8_t IN_PAIR_WORK = 2;
+
+    }
+
+    void MinesweeperSolver::reset(const MinesweeperGame& game) {
+        rows = game.rows;
+        cols = game.cols;
+        mines = game.numMines;
+        size_t n = static_cast<size_t>(rows) * cols;
+        state.assign(n, UNKNOWN);
+        queued.assign(n, 0);
+        localId.assign(n, -1);
+        activeSlot.assign(n, -1);
+        work.clear();
+        pairWork.clear();
+        active.clear();
+        safeMoves.clear();
+        mineMoves.clear();
+        openCount = 0;
+        knownMines = 0;
+        unknownCount = static_cast<int>(n);
+        cursor = 0;
+        sync(game);
+    }
+
+    // Revealed tiles the solver has not seen yet mean the player moved on their own
+    void MinesweeperSolver::sync(const MinesweeperGame& game) {
+        int revealedSafe = rows * cols - mines - game.safeTilesLeft();
+        if (revealedSafe == openCount || game.gameOver) return;
+        if (revealedSafe < openCount) {     // a new round on the same board size
+            reset(game);
+            return;
+        }
+        const MinesweeperTile* tiles = game.data();
+        for (int i = 0; i < rows * cols; ++i)
+            if (tiles[i].revealed() && state[i] != OPEN)
+                markOpen(game, i);
+    }
+
+    void MinesweeperSolver::observe(const MinesweeperGame& game, int r, int c) {
+        if (game.gameOver || !game.inside(r, c) || !game.at(r, c).revealed()) return;
+        int start = index(r, c);
+        if (state[start] == OPEN) return;
+
+        markOpen(game, start);
+        observeQueue.clear();
+        observeQueue.push_back(start);
+        for (size_t head = 0; head < observeQueue.size(); ++head) {
+            int i = observeQueue[head];
+            if (game.data()[i].adjacentMines() != 0) continue;
+            int tr = i / cols, tc = i % cols;
+            for (int nr = std::max(0, tr - 1); nr <= std::min(rows - 1, tr + 1); ++nr)
+                for (int nc = std::max(0, tc - 1); nc <= std::min(cols - 1, tc + 1); ++nc) {
+                    int j = index(nr, nc);
+                    if (state[j] != OPEN && game.data()[j].revealed()) {
+                        markOpen(game, j);
+                        observeQueue.push_back(j);
+                    }
+                }
+        }
+    }
+
+    void MinesweeperSolver::markOpen(const MinesweeperGame& game, int i) {
+        if (state[i] == UNKNOWN) unknownCount--;
+        state[i] = OPEN;
+        openCount++;
+        if (game.data()[i].adjacentMines() > 0) {
+            activeSlot[i] = static_cast<int>(active.size());
+            active.push_back(i);
+            recheck(i);
+        }
+        touchNeighbours(i);
+    }
+
+    void MinesweeperSolver::markSafe(int i) {
+        if (state[i] != UNKNOWN) return;
+        state[i] = SAFE_TILE;
+        unknownCount--;
+        deductions++;
+        safeMoves.push_back(i);
+        touchNeighbours(i);
+    }
+
+    void MinesweeperSolver::markMine(int i) {
+        if (state[i] != UNKNOWN) return;
+        state[i] = MINE_TILE;
+        unknownCount--;
+        knownMines++;
+        deductions++;
+        mineMoves.push_back(i);
+        touchNeighbours(i);
+    }
+
+    // The open numbers around a newly settled tile have one fewer unknown
+    void MinesweeperSolver::touchNeighbours(int i) {
+        int r = i / cols, c = i % cols;
+        for (int nr = std::max(0, r - 1); nr <= std::min(rows - 1, r + 1); ++nr)
+            for (int nc = std::max(0, c - 1); nc <= std::min(cols - 1, c + 1); ++nc) {
+                int j = index(nr, nc);
+                if (state[j] == OPEN) recheck(j);
+            }
+    }
+
+    void MinesweeperSolver::recheck(int i) {
+        if (!(queued[i] & IN_WORK)) {
+            queued[i] |= IN_WORK;
+            work.push_back(i);
+        }
+        if (!(queued[i] & IN_PAIR_WORK)) {
+            queued[i] |= IN_PAIR_WORK;
+            pairWork.push_back(i);
+        }
+    }
+
+    bool MinesweeperSolver::constraintAt(const MinesweeperGame& game, int i, Constraint& out) const {
+        out.count = 0;
+        out.mines = game.data()[i].adjacentMines();
+        int r = i / cols, c = i % cols;
+        for (int nr = std::max(0, r - 1); nr <= std::min(rows - 1, r + 1); ++nr)
+            for (int nc = std::max(0, c - 1); nc <= std::min(cols - 1, c + 1); ++nc) {
+                int j = index(nr, nc);
+                if (state[j] == UNKNOWN) out.tiles[out.count++] = j;
+                else if (state[j] == MINE_TILE) out.mines--;
+            }
+        return out.count > 0;
+    }
+
+    bool MinesweeperSolver::singlePoint(const MinesweeperGame& game) {
+        bool progress = false;
+        Constraint con;
+        while (!work.empty()) {
+            int i = work.back();
+            work.pop_back();
+            queued[i] &= ~IN_WORK;
+            if (game.data()[i].adjacentMines() == 0) continue;
+            if (!constraintAt(game, i, con)) {
+                removeActive(i);
+                continue;
+            }
+            if (con.mines == 0) {
+                for (int k = 0; k < con.count; ++k) markSafe(con.tiles[k]);
+                progress = true;
+            }
+            else if (con.mines == con.count) {
+                for (int k = 0; k < con.count; ++k) markMine(con.tiles[k]);
+                progress = true;
+            }
+        }
+        return progress;
+    }
+
+    // If A's hidden tiles are a subset of B's, B's remaining tiles hold exactly
+    // B's mines minus A's. A pair can only change when a tile next to one of the
+    // two is settled, so only numbers touched since the last pass are compared,
+    // each against every open number within two tiles, in both directions.
+    bool MinesweeperSolver::subsets(const MinesweeperGame& game) {
+        bool progress = false;
+        Constraint a, b;
+        while (!pairWork.empty() && !progress) {
+            int i = pairWork.back();
+            pairWork.pop_back();
+            queued[i] &= ~IN_PAIR_WORK;
+            if (game.data()[i].adjacentMines() == 0 || !constraintAt(game, i, a)) continue;
+
+            int r = i / cols, c = i % cols;
+            for (int nr = std::max(0, r - 2); nr <= std::min(rows - 1, r + 2) && !progress; ++nr)
+                for (int nc = std::max(0, c - 2); nc <= std::min(cols - 1, c + 2) && !progress; ++nc) {
+                    int j = index(nr, nc);
+                    if (j == i || state[j] != OPEN || game.data()[j].adjacentMines() == 0) continue;
+                    if (!constraintAt(game, j, b) || b.count == a.count) continue;
+
+                    const Constraint& inner = a.count < b.count ? a : b;
+                    const Constraint& outer = a.count < b.count ? b : a;
+                    int rest[8], restCount = 0, shared = 0;
+                    for (int q = 0; q < outer.count; ++q) {
+                        if (std::find(inner.tiles, inner.tiles + inner.count, outer.tiles[q]) != inner.tiles + inner.count) shared++;
+                        else rest[restCount++] = outer.tiles[q];
+                    }
+                    if (shared != inner.count) continue;
+
+                    int restMines = outer.mines - inner.mines;
+                    if (restMines == 0) {
+                        for (int q = 0; q < restCount; ++q) markSafe(rest[q]);
+                        progress = true;
+                    }
+                    else if (restMines == restCount) {
+                        for (int q = 0; q < restCount; ++q) markMine(rest[q]);
+                        progress = true;
+                    }
+                }
+            // Settling tiles re-queued i's neighbours; i itself may still pair with others
+            if (progress) recheck(i);
+        }
+        return progress;
+    }
+
+    // A number whose neighbours are all settled never constrains anything again.
+    // Dropping it as singlePoint() finds it keeps active at the frontier, so a guess
+    // does not first have to sweep every number opened since the last one.
+    void MinesweeperSolver::removeActive(int i) {
+        int slot = activeSlot[i];
+        if (slot < 0) return;
+        active[slot] = active.back();
+        activeSlot[active[slot]] = slot;
+        active.pop_back();
+        activeSlot[i] = -1;
+    }
+
+    // Splits the frontier into groups of constraints that share hidden tiles
+    void MinesweeperSolver::buildGroups(const MinesweeperGame& game) {
+        groups.clear();
+        groupConstraints.clear();
+
+        std::vector<int> frontier;
+        std::vector<std::vector<int>> cellConstraints;
+        Constraint con;
+        for (int i : active) {
+            if (!constraintAt(game, i, con)) continue;
+            int id = static_cast<int>(groupConstraints.size());
+            groupConstraints.push_back(con);
+            for (int k = 0; k < con.count; ++k) {
+                int t = con.tiles[k];
+                if (localId[t] < 0) {
+                    localId[t] = static_cast<int>(frontier.size());
+                    frontier.push_back(t);
+                    cellConstraints.emplace_back();
+                }
+                cellConstraints[localId[t]].push_back(id);
+            }
+        }
+
+        std::vector<uint8_t> constraintSeen(groupConstraints.size(), 0);
+        std::vector<uint8_t> cellSeen(frontier.size(), 0);
+        std::vector<int> pending;
+        for (size_t start = 0; start < groupConstraints.size(); ++start) {
+            if (constraintSeen[start]) continue;
+            Group group;
+            constraintSeen[start] = 1;
+            pending.assign(1, static_cast<int>(start));
+            while (!pending.empty()) {
+                int ci = pending.back();
+                pending.pop_back();
+                group.constraints.push_back(ci);
+                const Constraint& gc = groupConstraints[ci];
+                for (int k = 0; k < gc.count; ++k) {
+                    int cell = localId[gc.tiles[k]];
+                    if (cellSeen[cell]) continue;
+                    cellSeen[cell] = 1;
+                    group.cells.push_back(gc.tiles[k]);
+                    for (int other : cellConstraints[cell])
+                        if (!constraintSeen[other]) {
+                            constraintSeen[other] = 1;
+                            pending.push_back(other);
+                        }
+                }
+            }
+            groups.push_back(std::move(group));
+        }
+    }
+
+    // Counts the group's consistent mine layouts, by total mines and per tile. The
+    // steps used come off budget; a group that runs out is left without solutions.
+    void MinesweeperSolver::enumerate(Group& group, long& budget) {
+        int cells = static_cast<int>(group.cells.size());
+        group.solutions.clear();
+        group.cellMines.clear();
+        if (cells > MAX_ENUMERATED_CELLS || budget <= 0) return;
+
+        for (int k = 0; k < cells; ++k)
+            localId[group.cells[k]] = k;
+        std::vector<std::vector<int>> cellConstraints(cells);
+        Enumeration e;
+        for (size_t k = 0; k < group.constraints.size(); ++k) {
+            const Constraint& gc = groupConstraints[group.constraints[k]];
+            for (int q = 0; q < gc.count; ++q)
+                cellConstraints[localId[gc.tiles[q]]].push_back(static_cast<int>(k));
+            e.need.push_back(gc.mines);
+            e.left.push_back(gc.count);
+        }
+
+        std::vector<double> solutions(cells + 1, 0.0);
+        std::vector<double> cellMines(static_cast<size_t>(cells + 1) * cells, 0.0);
+        e.cellConstraints = &cellConstraints;
+        e.value.assign(cells, 0);
+        e.solutions = &solutions;
+        e.cellMines = &cellMines;
+        e.cells = cells;
+        e.budget = budget;
+        bool finished = e.run(0);
+        budget -= e.steps;
+        if (!finished) return;
+
+        group.solutions = solutions;
+        for (int k = 0; k <= cells; ++k)
+            group.cellMines.emplace_back(cellMines.begin() + static_cast<size_t>(k) * cells,
+                cellMines.begin() + static_cast<size_t>(k + 1) * cells);
+    }
+
+    MinesweeperSolver::Move MinesweeperSolver::guess(const MinesweeperGame& game) {
+        buildGroups(game);
+        int frontierCells = 0;
+        long budget = ENUMERATION_BUDGET;
+        for (Group& group : groups) {
+            enumerate(group, budget);
+            frontierCells += static_cast<int>(group.cells.size());
+        }
+
+        int remaining = mines - knownMines;
+        int others = unknownCount - frontierCells;
+
+        // Estimate per tile; exact groups may also prove tiles safe or mined outright
+        std::vector<double> chance;
+        std::vector<int> chanceTile;
+        double frontierMines = 0;
+        bool exactTotals = frontierCells <= EXACT_FRONTIER_LIMIT;
+        for (const Group& group : groups)
+            if (group.solutions.empty()) exactTotals = false;
+
+        std::vector<double> weight;             // by frontier mine total
+        std::vector<std::vector<double>> without;  // per group: distribution of all the others
+        if (exactTotals) {
+            std::vector<std::vector<double>> prefix(1, std::vector<double>(1, 1.0));
+            for (const Group& group : groups) {
+                double total = 0;
+                for (double s : group.solutions) total += s;
+                std::vector<double> normalised = group.solutions;
+                for (double& s : normalised) s /= total;
+                prefix.push_back(convolve(prefix.back(), normalised));
+            }
+            std::vector<double> suffix(1, 1.0);
+            without.resize(groups.size());
+            for (size_t g = groups.size(); g-- > 0;) {
+                without[g] = convolve(prefix[g], suffix);
+                double total = 0;
+                for (double s : groups[g].solutions) total += s;
+                std::vector<double> normalised = groups[g].solutions;
+                for (double& s : normalised) s /= total;
+                suffix = convolve(normalised, suffix);
+            }
+
+            // C(others, remaining - t) ways to place the rest, kept in log space
+            const std::vector<double>& all = prefix.back();
+            std::vector<double> logWeight(all.size());
+            double top = -INFINITY;
+            for (size_t t = 0; t < all.size(); ++t) {
+                logWeight[t] = logChoose(others, remaining - static_cast<int>(t));
+                top = std::max(top, logWeight[t]);
+            }
+            weight.resize(all.size());
+            for (size_t t = 0; t < all.size(); ++t)
+                weight[t] = std::isinf(logWeight[t]) ? 0.0 : std::exp(logWeight[t] - top);
+
+            double z = 0, restMines = 0;
+            for (size_t t = 0; t < all.size(); ++t) {
+                z += all[t] * weight[t];
+                restMines += all[t] * weight[t] * (remaining - static_cast<int>(t));
+            }
+            if (z <= 0) exactTotals = false;    // inconsistent totals; fall back
+            else {
+                for (size_t g = 0; g < groups.size(); ++g) {
+                    const Group& group = groups[g];
+                    double total = 0;
+                    for (double s : group.solutions) total += s;
+                    std::vector<double> byCount(group.solutions.size(), 0.0);
+                    for (size_t k = 0; k < byCount.size(); ++k)
+                        for (size_t t = 0; t < without[g].size(); ++t)
+                            byCount[k] += without[g][t] * weight[k + t];
+                    for (size_t cell = 0; cell < group.cells.size(); ++cell) {
+                        double p = 0;
+                        for (size_t k = 0; k < byCount.size(); ++k)
+                            p += group.cellMines[k][cell] / total * byCount[k];
+                        chance.push_back(p / z);
+                        chanceTile.push_back(group.cells[cell]);
+                    }
+                }
+                frontierMines = remaining - restMines / z;
+            }
+        }
+
+        if (!exactTotals) {
+            // Each extra frontier mine costs a factor of about density / (1 - density)
+            chance.clear();
+            chanceTile.clear();
+            double density = unknownCount > 0 ? static_cast<double>(remaining) / unknownCount : 0.0;
+            density = std::min(std::max(density, 1e-6), 1 - 1e-6);
+            double logRatio = std::log(density / (1 - density));
+            for (const Group& group : groups) {
+                if (group.solutions.empty()) {
+                    // Too large to enumerate: average of the local ratios
+                    for (int t : group.cells) {
+                        double sum = 0;
+                        int n = 0;
+                        for (int ci : group.constraints) {
+                            const Constraint& gc = groupConstraints[ci];
+                            if (std::find(gc.tiles, gc.tiles + gc.count, t) != gc.tiles + gc.count) {
+                                sum += static_cast<double>(gc.mines) / gc.count;
+                                n++;
+                            }
+                        }
+                        chance.push_back(n ? sum / n : density);
+                        chanceTile.push_back(t);
+                        frontierMines += chance.back();
+                    }
+                    continue;
+                }
+                double z = 0;
+                std::vector<double> w(group.solutions.size());
+                for (size_t k = 0; k < w.size(); ++k) {
+                    w[k] = std::exp(logRatio * k - logRatio * (w.size() - 1) / 2);
+                    z += group.solutions[k] * w[k];
+                }
+                for (size_t cell = 0; cell < group.cells.size(); ++cell) {
+                    double p = 0;
+                    for (size_t k = 0; k < w.size(); ++k)
+                        p += group.cellMines[k][cell] * w[k];
+                    chance.push_back(z > 0 ? p / z : density);
+                    chanceTile.push_back(group.cells[cell]);
+                    frontierMines += chance.back();
+                }
+            }
+        }
+
+        double otherChance = others > 0
+            ? std::min(1.0, std::max(0.0, (remaining - frontierMines) / others)) : 2.0;
+
+        // Exactly settled tiles are deductions, not guesses
+        bool settled = false;
+        if (exactTotals) {
+            for (size_t k = 0; k < chance.size(); ++k) {
+                if (chance[k] <= 0.0) { markSafe(chanceTile[k]); settled = true; }
+                else if (chance[k] >= 1.0) { markMine(chanceTile[k]); settled = true; }
+            }
+        }
+
+        Move move;
+        if (!settled) {
+            size_t best = chance.size();
+            for (size_t k = 0; k < chance.size(); ++k)
+                if (best == chance.size() || chance[k] < chance[best]) best = k;
+            if (best < chance.size() && chance[best] <= otherChance) {
+                move.row = chanceTile[best] / cols;
+                move.col = chanceTile[best] % cols;
+                move.reason = GUESS;
+                move.mineChance = static_cast<float>(chance[best]);
+            }
+            else if (others > 0) {
+                move = unconstrainedMove(static_cast<float>(otherChance));
+            }
+            if (move.reason == GUESS) guesses++;
+        }
+
+        for (const Group& group : groups)
+            for (int t : group.cells)
+                localId[t] = -1;
+        return settled ? next(game) : move;
+    }
+
+    // A hidden tile away from the frontier; corners first, since they open up most often
+    MinesweeperSolver::Move MinesweeperSolver::unconstrainedMove(float chance) {
+        Move move;
+        move.reason = GUESS;
+        move.mineChance = chance;
+        int corners[4] = { 0, cols - 1, (rows - 1) * cols, rows * cols - 1 };
+        for (int t : corners)
+            if (state[t] == UNKNOWN && localId[t] < 0) {
+                move.row = t / cols;
+                move.col = t % cols;
+                return move;
+            }
+        int n = rows * cols;
+        for (int step = 0; step < n; ++step) {
+            int t = (cursor + step) % n;
+            if (state[t] == UNKNOWN && localId[t] < 0) {
+                cursor = t;
+                move.row = t / cols;
+                move.col = t % cols;
+                return move;
+            }
+        }
+        return Move();
+    }
+
+    MinesweeperSolver::Move MinesweeperSolver::next(const MinesweeperGame& game) {
+        if (rows != game.rows || cols != game.cols || mines != game.numMines)
+            reset(game);
+        else
+            sync(game);
+        if (game.gameOver) return Move();
+
+        Move move;
+        for (;;) {
+            while (!safeMoves.empty()) {
+                int t = safeMoves.back();
+                if (!game.data()[t].revealed()) {
+                    move.row = t / cols;
+                    move.col = t % cols;
+                    move.reason = SAFE;
+                    return move;
+                }
+                safeMoves.pop_back();
+            }
+            if (singlePoint(game)) continue;
+            if (subsets(game)) continue;
+            break;
+        }
+
+        while (!mineMoves.empty()) {
+            int t = mineMoves.back();
+            if (!game.data()[t].flagged()) {
+                move.row = t / cols;
+                move.col = t % cols;
+                move.reason = MINE;
+                move.mineChance = 1.f;
+                return move;
+            }
+            mineMoves.pop_back();
+        }
+
+        if (unknownCount == 0) return move;
+        return guess(game);
+    }
+
+    bool MinesweeperSolver::play(MinesweeperGame& game) {
+        reset(game);
+        while (!game.gameOver) {
+            Move move = next(game);
+            if (move.reason == NONE) break;
+            if (move.reason == MINE) {
+                game.apply(MinesweeperGame::FLAG, move.row, move.col);
+                continue;
+            }
+            game.apply(MinesweeperGame::REVEAL, move.row, move.col);
+            observe(game, move.row, move.col);
+        }
+        return game.won;
+    }
+
+}
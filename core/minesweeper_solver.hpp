@@ -0,0 +1,104 @@
+#ifndef MINESWEEPER_SOLVER_HPP
+#define MINESWEEPER_SOLVER_HPP
+
+#include "minesweeper_core.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    // Plays Minesweeper from what a player can see: revealed numbers only, never the
+    // hidden mine bits. Deductions run in three stages, each only when the one
+    // before finds nothing:
+    //   1. single tiles: a number whose mines are all known, or whose hidden
+    //      neighbours must all be mines;
+    //   2. pairs of nearby numbers where one's hidden tiles are a subset of the other's;
+    //   3. mine probabilities for every frontier tile, by enumerating each connected
+    //      group of constraints and weighting by the mines left on the whole board.
+    // Knowledge is kept between calls and updated incrementally, so a move costs
+    // roughly the tiles it changes rather than the board size.
+    class MinesweeperSolver {
+    public:
+        enum Reason { SAFE, MINE, GUESS, NONE };
+
+        struct Move {
+            int row = -1;
+            int col = -1;
+            Reason reason = NONE;
+            float mineChance = 0.f;     // 0 for SAFE, 1 for MINE, estimated for GUESS
+        };
+
+        // Frontiers up to this many tiles are weighted exactly against the global mine
+        // count; larger ones use the binomial approximation of that weight
+        static const int EXACT_FRONTIER_LIMIT = 256;
+        // Search steps for all constraint groups in one next() call, which keeps a hint
+        // within a frame; groups left over when it runs out use local estimates
+        static const int ENUMERATION_BUDGET = 200000;
+
+        void reset(const MinesweeperGame& game);
+        // Picks up the tiles opened by a reveal at (r, c); next() also notices
+        // reveals it was not told about, at the cost of one board scan
+        void observe(const MinesweeperGame& game, int r, int c);
+        // Best move for the current position: a certain safe tile, then a certain
+        // mine that is not flagged yet, then the tile least likely to be a mine
+        Move next(const MinesweeperGame& game);
+        // Plays until the round ends, flagging deduced mines along the way; true on a win
+        bool play(MinesweeperGame& game);
+
+        long long deductions = 0;   // tiles settled by stages 1 and 2
+        long long guesses = 0;      // moves taken from stage 3
+
+    private:
+        enum State : uint8_t { UNKNOWN, SAFE_TILE, MINE_TILE, OPEN };
+
+        struct Constraint {
+            int tiles[8];
+            int count;
+            int mines;              // still to place among tiles
+        };
+
+        struct Group {
+            std::vector<int> cells;                 // board indices
+            std::vector<int> constraints;           // indices into groupConstraints
+            std::vector<double> solutions;          // by mine count
+            std::vector<std::vector<double>> cellMines; // [mine count][cell]
+        };
+
+        int index(int r, int c) const { return r * cols + c; }
+        void sync(const MinesweeperGame& game);
+        void markOpen(const MinesweeperGame& game, int i);
+        void markSafe(int i);
+        void markMine(int i);
+        void touchNeighbours(int i);
+        void recheck(int i);
+        bool constraintAt(const MinesweeperGame& game, int i, Constraint& out) const;
+        bool singlePoint(const MinesweeperGame& game);
+        bool subsets(const MinesweeperGame& game);
+        void removeActive(int i);
+        Move guess(const MinesweeperGame& game);
+        void buildGroups(const MinesweeperGame& game);
+        void enumerate(Group& group, long& budget);
+        Move unconstrainedMove(float chance);
+
+        int rows = 0, cols = 0, mines = 0;
+        int openCount = 0;
+        int knownMines = 0;
+        int unknownCount = 0;
+        std::vector<uint8_t> state;
+        std::vector<uint8_t> queued;    // IN_WORK / IN_PAIR_WORK bits
+        std::vector<int> work;          // open numbers to re-check on their own
+        std::vector<int> pairWork;      // open numbers to re-check against their neighbours
+        std::vector<int> active;        // open numbers with hidden neighbours, once work is drained
+        std::vector<int> activeSlot;    // board index -> position in active, or -1
+        std::vector<int> safeMoves;
+        std::vector<int> mineMoves;
+        std::vector<int> observeQueue;
+        std::vector<int> localId;       // board index -> cell id within its group, or -1
+        std::vector<Group> groups;
+        std::vector<Constraint> groupConstraints;
+        int cursor = 0;                 // where the search for an unconstrained tile resumes
+    };
+
+}
+
+#endif // MINESWEEPER_SOLVER_HPP
@@ -0,0 +1,178 @@
+#include "minesweeper_world.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace core {
+
+    namespace {
+
+        uint64_t mix(uint64_t z) {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+    }
+
+    MinesweeperWorld::MinesweeperWorld(uint64_t seed, float density) {
+        density = std::max(MIN_DENSITY, std::min(density, MAX_DENSITY));
+        threshold = static_cast<uint32_t>(density * 4294967296.0);
+        reset(seed);
+    }
+
+    void MinesweeperWorld::reset(uint64_t newSeed) {
+        seed = newSeed;
+        chunks.clear();
+        played = 0;
+        lastChunk = nullptr;
+        revealedCount = 0;
+        gameOver = false;
+        timerRunning = true;
+        elapsed = 0.f;
+    }
+
+    void MinesweeperWorld::step(float dt) {
+        if (timerRunning)
+            elapsed += dt;
+    }
+
+    bool MinesweeperWorld::mineAt(int r, int c) const {
+        if (std::abs(r) <= 1 && std::abs(c) <= 1) return false;
+        uint64_t h = mix(seed + 0x9E3779B97F4A7C15ull * (key(r, c) + 1));
+        return static_cast<uint32_t>(h >> 32) < threshold;
+    }
+
+    // Mines for the chunk plus a one-tile border taken from its neighbours' coordinates
+    // (computed, not looked up), then a 3x3 count per tile
+    MinesweeperWorld::Chunk& MinesweeperWorld::chunkAt(int cr, int cc) {
+        uint64_t k = key(cr, cc);
+        if (lastChunk && lastKey == k) return *lastChunk;
+
+        std::unique_ptr<Chunk>& slot = chunks[k];
+        if (!slot) {
+            slot = std::make_unique<Chunk>();
+            const int PADDED = CHUNK_SIZE + 2;
+            uint8_t mines[PADDED * PADDED];
+            int r0 = cr * CHUNK_SIZE - 1, c0 = cc * CHUNK_SIZE - 1;
+            for (int r = 0; r < PADDED; ++r)
+                for (int c = 0; c < PADDED; ++c)
+                    mines[r * PADDED + c] = mineAt(r0 + r, c0 + c);
+
+            for (int r = 0; r < CHUNK_SIZE; ++r)
+                for (int c = 0; c < CHUNK_SIZE; ++c) {
+                    MinesweeperTile& t = slot->tiles[r * CHUNK_SIZE + c];
+                    const uint8_t* centre = &mines[(r + 1) * PADDED + c + 1];
+                    if (*centre) {
+                        t.set(MinesweeperTile::MINE);
+                        continue;
+                    }
+                    int count = centre[-PADDED - 1] + centre[-PADDED] + centre[-PADDED + 1] +
+                        centre[-1] + centre[1] + centre[PADDED - 1] + centre[PADDED] + centre[PADDED + 1];
+                    t.setAdjacentMines(count);
+                }
+        }
+        lastKey = k;
+        lastChunk = slot.get();
+        return *lastChunk;
+    }
+
+    const MinesweeperTile* MinesweeperWorld::chunk(int cr, int cc) {
+        return chunkAt(cr, cc).tiles;
+    }
+
+    MinesweeperTile& MinesweeperWorld::tile(int r, int c) {
+        Chunk& ch = chunkAt(chunkOf(r), chunkOf(c));
+        return ch.tiles[(r & (CHUNK_SIZE - 1)) * CHUNK_SIZE + (c & (CHUNK_SIZE - 1))];
+    }
+
+    const MinesweeperTile& MinesweeperWorld::at(int r, int c) {
+        return tile(r, c);
+    }
+
+    // Marks the chunk of the tile last passed to tile() as holding player state
+    void MinesweeperWorld::markPlayed() {
+        if (!lastChunk->played) {
+            lastChunk->played = true;
+            played++;
+        }
+    }
+
+    bool MinesweeperWorld::apply(MinesweeperGame::Action action, int r, int c) {
+        if (gameOver) return false;
+
+        MinesweeperTile& t = tile(r, c);
+        if (action == MinesweeperGame::FLAG) {
+            if (t.revealed()) return false;
+            if (t.flagged()) t.clear(MinesweeperTile::FLAGGED);
+            else t.set(MinesweeperTile::FLAGGED);
+            markPlayed();
+            return true;
+        }
+
+        if (t.flagged()) return false;
+        if (t.mine()) {
+            // ---- LOSS ---- (only the mine clicked is shown; the rest of the world is endless)
+            t.set(MinesweeperTile::REVEALED);
+            markPlayed();
+            gameOver = true;
+            timerRunning = false;
+        }
+        else {
+            reveal(r, c);
+        }
+        return true;
+    }
+
+    // Depth-first flood fill over world coordinates. tile() builds chunks as the fill
+    // crosses into them, so borders need no special case; the density floor keeps
+    // every blank region finite.
+    void MinesweeperWorld::reveal(int r, int c) {
+        MinesweeperTile& start = tile(r, c);
+        if (start.revealed()) return;
+        start.set(MinesweeperTile::REVEALED);
+        markPlayed();
+        revealedCount++;
+        if (start.adjacentMines() != 0) return;
+
+        const uint8_t STOP = MinesweeperTile::REVEALED | MinesweeperTile::FLAGGED;
+        revealStack.clear();
+        revealStack.push_back(Cell{ r, c });
+        while (!revealStack.empty()) {
+            Cell cell = revealStack.back();
+            revealStack.pop_back();
+            for (int nr = cell.r - 1; nr <= cell.r + 1; ++nr)
+                for (int nc = cell.c - 1; nc <= cell.c + 1; ++nc) {
+                    MinesweeperTile& t = tile(nr, nc);
+                    if (t.bits & STOP) continue;
+                    t.set(MinesweeperTile::REVEALED);
+                    markPlayed();
+                    revealedCount++;
+                    if (t.adjacentMines() == 0)
+                        revealStack.push_back(Cell{ nr, nc });
+                }
+        }
+    }
+
+    void MinesweeperWorld::evictFar(int r, int c, int radius) {
+        int cr = chunkOf(r), cc = chunkOf(c);
+        for (auto it = chunks.begin(); it != chunks.end();) {
+            int kr = static_cast<int>(static_cast<uint32_t>(it->first >> 32));
+            int kc = static_cast<int>(static_cast<uint32_t>(it->first));
+            bool far = std::abs(kr - cr) > radius || std::abs(kc - cc) > radius;
+            if (far && !it->second->played) {
+                if (it->second.get() == lastChunk) lastChunk = nullptr;
+                it = chunks.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    size_t MinesweeperWorld::memoryBytes() const {
+        const size_t NODE = sizeof(uint64_t) + sizeof(std::unique_ptr<Chunk>) + 2 * sizeof(void*);
+        return chunks.size() * (sizeof(Chunk) + NODE) + chunks.bucket_count() * sizeof(void*) +
+            revealStack.capacity() * sizeof(Cell);
+    }
+
+}
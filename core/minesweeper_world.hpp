@@ -0,0 +1,84 @@
+#ifndef MINESWEEPER_WORLD_HPP
+#define MINESWEEPER_WORLD_HPP
+
+#include "minesweeper_core.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+    // Endless Minesweeper: an unbounded board stored as CHUNK_SIZE square chunks in a
+    // hash map. Whether a tile holds a mine is a pure function of the world seed and
+    // its coordinates, so a chunk is built only when a reveal or the view reaches it,
+    // and one nobody has played in can be dropped and rebuilt identically later.
+    // Memory follows the chunks played in plus whatever cache the caller keeps.
+    // Coordinates are any (row, col); the 3x3 block around (0, 0) never holds a mine.
+    class MinesweeperWorld {
+    public:
+        static constexpr int CHUNK_SHIFT = 6;
+        static constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+        // Below this density blank tiles connect without end and a flood fill never stops
+        static constexpr float MIN_DENSITY = 0.12f;
+        static constexpr float MAX_DENSITY = 0.9f;
+
+        explicit MinesweeperWorld(uint64_t seed = 0, float density = 0.18f);
+
+        void reset(uint64_t seed);
+        bool apply(MinesweeperGame::Action action, int r, int c);
+        void step(float dt);
+
+        // Builds the chunk holding (r, c) if needed
+        const MinesweeperTile& at(int r, int c);
+        // The CHUNK_SIZE x CHUNK_SIZE tiles of chunk (cr, cc), row-major, built if needed
+        const MinesweeperTile* chunk(int cr, int cc);
+        static int chunkOf(int v) { return v >> CHUNK_SHIFT; }    // rounds towards minus infinity
+
+        // Drops every chunk without revealed or flagged tiles whose centre lies more
+        // than radius chunks from (r, c) on either axis
+        void evictFar(int r, int c, int radius);
+
+        size_t chunkCount() const { return chunks.size(); }
+        size_t playedChunks() const { return played; }
+        size_t memoryBytes() const;
+
+        long long revealedCount = 0;    // the score
+        bool gameOver = false;
+        bool timerRunning = true;
+        float elapsed = 0.f;
+
+    private:
+        struct Chunk {
+            MinesweeperTile tiles[CHUNK_SIZE * CHUNK_SIZE];
+            bool played = false;        // holds player state, so it is never evicted
+        };
+
+        static uint64_t key(int cr, int cc) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(cr)) << 32) | static_cast<uint32_t>(cc);
+        }
+        bool mineAt(int r, int c) const;
+        Chunk& chunkAt(int cr, int cc);
+        MinesweeperTile& tile(int r, int c);
+        void markPlayed();
+        void reveal(int r, int c);
+
+        uint64_t seed;
+        uint32_t threshold;             // a tile is a mine when its hash falls below this
+        std::unordered_map<uint64_t, std::unique_ptr<Chunk>> chunks;
+        size_t played = 0;
+
+        // Last chunk looked up; flood fills stay inside one chunk for long runs
+        uint64_t lastKey = 0;
+        Chunk* lastChunk = nullptr;
+
+        struct Cell {
+            int r, c;
+        };
+        std::vector<Cell> revealStack;
+    };
+
+}
+
+#endif // MINESWEEPER_WORLD_HPP
@@ -0,0 +1,227 @@
+#ifndef MNK_ENGINE_HPP
+#define MNK_ENGINE_HPP
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+
+namespace core {
+
+    // Occupancy set for one side: a single uint64_t when the board fits, std::bitset beyond that
+    template <int Cells, bool Small = (Cells <= 64)>
+    struct MnkBits {
+        uint64_t bits = 0;
+        bool test(int i) const { return (bits >> i) & 1; }
+        void set(int i) { bits |= uint64_t(1) << i; }
+        void reset(int i) { bits &= ~(uint64_t(1) << i); }
+        void clear() { bits = 0; }
+    };
+
+    template <int Cells>
+    struct MnkBits<Cells, false> {
+        std::bitset<Cells> bits;
+        bool test(int i) const { return bits.test(i); }
+        void set(int i) { bits.set(i); }
+        void reset(int i) { bits.reset(i); }
+        void clear() { bits.reset(); }
+    };
+
+    // Size-independent view used by the front-end to switch between board sizes
+    class MnkGameBase {
+    public:
+        virtual ~MnkGameBase() {}
+
+        virtual int rows() const = 0;
+        virtual int cols() const = 0;
+        virtual int winLength() const = 0;
+        virtual void reset() = 0;
+        virtual bool apply(int row, int col) = 0;
+        virtual char at(int row, int col) const = 0;    // 'X', 'O' or ' '
+        virtual int chooseMove() = 0;                   // cell index for the side to move, -1 if over
+
+        char currentPlayer() const { return (moves & 1) ? 'O' : 'X'; }
+
+        int moves = 0;
+        char winner = 0;        // 0 while playing or on a draw
+        bool gameOver = false;
+    };
+
+    // M x N board, K in a row wins. Wins are checked only along the lines through the
+    // last move. The AI is a depth-limited alpha-beta that only looks at cells near
+    // existing stones, answers forced threats first and keeps the `beam` most
+    // threatening candidates at every node.
+    template <int M, int N, int K>
+    class MnkGame : public MnkGameBase {
+    public:
+        static constexpr int CELLS = M * N;
+        static constexpr int WIN = 1000000;
+
+        explicit MnkGame(int depth = 4, int beam = 8) : searchDepth(depth), beamWidth(beam) { reset(); }
+
+        int rows() const override { return M; }
+        int cols() const override { return N; }
+        int winLength() const override { return K; }
+
+        void reset() override {
+            stones[0].clear();
+            stones[1].clear();
+            moves = 0;
+            winner = 0;
+            gameOver = false;
+        }
+
+        char at(int row, int col) const override {
+            int cell = row * N + col;
+            return stones[0].test(cell) ? 'X' : stones[1].test(cell) ? 'O' : ' ';
+        }
+
+        bool apply(int row, int col) override {
+            if (gameOver || row < 0 || row >= M || col < 0 || col >= N || !isEmpty(row * N + col))
+                return false;
+            int side = moves & 1;
+            int cell = row * N + col;
+            place(side, cell);
+            if (runThrough(side, cell) >= K) {
+                winner = side ? 'O' : 'X';
+                gameOver = true;
+            }
+            else if (moves == CELLS) {
+                gameOver = true;
+            }
+            return true;
+        }
+
+        int chooseMove() override {
+            if (gameOver) return -1;
+            if (moves == 0) return (M / 2) * N + N / 2;
+            int best = -1;
+            search(searchDepth, -2 * WIN, 2 * WIN, &best);
+            return best;
+        }
+
+        int searchDepth;
+        int beamWidth;
+
+    private:
+        MnkBits<CELLS> stones[2];
+
+        static constexpr int dr[4] = { 0, 1, 1, 1 };
+        static constexpr int dc[4] = { 1, 0, 1, -1 };
+
+        bool isEmpty(int cell) const { return !stones[0].test(cell) && !stones[1].test(cell); }
+        void place(int side, int cell) { stones[side].set(cell); moves++; }
+        void remove(int side, int cell) { stones[side].reset(cell); moves--; }
+
+        bool isSide(int side, int r, int c) const {
+            return r >= 0 && r < M && c >= 0 && c < N && stones[side].test(r * N + c);
+        }
+        bool isOpen(int r, int c) const {
+            return r >= 0 && r < M && c >= 0 && c < N && isEmpty(r * N + c);
+        }
+
+        // Longest line of `side` through `cell` in any direction, counting `cell` itself
+        int runThrough(int side, int cell) const {
+            int r = cell / N, c = cell % N;
+            int longest = 0;
+            for (int d = 0; d < 4; ++d) {
+                int run = 1;
+                for (int i = 1; i < K && isSide(side, r + dr[d] * i, c + dc[d] * i); ++i) run++;
+                for (int i = 1; i < K && isSide(side, r - dr[d] * i, c - dc[d] * i); ++i) run++;
+                longest = std::max(longest, run);
+            }
+            return longest;
+        }
+
+        // How strong a stone for `side` on the empty `cell` would be
+        int threatScore(int side, int cell) const {
+            int r = cell / N, c = cell % N;
+            int score = 0;
+            for (int d = 0; d < 4; ++d) {
+                int run = 1, open = 0, i;
+                for (i = 1; i < K && isSide(side, r + dr[d] * i, c + dc[d] * i); ++i) run++;
+                open += isOpen(r + dr[d] * i, c + dc[d] * i);
+                for (i = 1; i < K && isSide(side, r - dr[d] * i, c - dc[d] * i); ++i) run++;
+                open += isOpen(r - dr[d] * i, c - dc[d] * i);
+
+                if (run >= K) return WIN;
+                if (open == 0) continue;
+                int missing = K - run;
+                int value = missing == 1 ? 20000 : missing == 2 ? 800 : missing == 3 ? 40 : 2;
+                score += open == 2 ? value * 4 : value;
+            }
+            return score;
+        }
+
+        // Empty cells within two steps of any stone
+        int candidates(int* out) const {
+            int count = 0;
+            for (int cell = 0; cell < CELLS; ++cell) {
+                if (!isEmpty(cell)) continue;
+                int r = cell / N, c = cell % N;
+                bool near = false;
+                for (int rr = std::max(0, r - 2); rr <= std::min(M - 1, r + 2) && !near; ++rr)
+                    for (int cc = std::max(0, c - 2); cc <= std::min(N - 1, c + 2) && !near; ++cc)
+                        near = !isEmpty(rr * N + cc);
+                if (near) out[count++] = cell;
+            }
+            return count;
+        }
+
+        int search(int depth, int alpha, int beta, int* bestMove) {
+            int side = moves & 1;
+            int cells[CELLS];
+            int count = candidates(cells);
+            if (count == 0) return 0;
+
+            int attack[CELLS], defend[CELLS], key[CELLS];
+            int bestAttack = 0, bestDefend = 0;
+            for (int i = 0; i < count; ++i) {
+                attack[i] = threatScore(side, cells[i]);
+                if (attack[i] >= WIN) {
+                    if (bestMove) *bestMove = cells[i];
+                    return WIN - moves;     // win now, sooner is better
+                }
+                defend[i] = threatScore(side ^ 1, cells[i]);
+                bestAttack = std::max(bestAttack, attack[i]);
+                bestDefend = std::max(bestDefend, defend[i]);
+            }
+
+            if (depth == 0)
+                return bestAttack - bestDefend / 2;
+
+            // The opponent wins next move unless we block, so only blocks are worth trying
+            int order[CELLS];
+            int kept = 0;
+            for (int i = 0; i < count; ++i) {
+                if (bestDefend >= WIN && defend[i] < WIN) continue;
+                key[i] = attack[i] + defend[i];
+                order[kept++] = i;
+            }
+            for (int i = 1; i < kept; ++i) {
+                int item = order[i], j = i;
+                for (; j > 0 && key[order[j - 1]] < key[item]; --j)
+                    order[j] = order[j - 1];
+                order[j] = item;
+            }
+            kept = std::min(kept, beamWidth);
+
+            int best = -2 * WIN;
+            for (int j = 0; j < kept; ++j) {
+                int cell = cells[order[j]];
+                place(side, cell);
+                int score = moves == CELLS ? 0 : -search(depth - 1, -beta, -alpha, nullptr);
+                remove(side, cell);
+                if (score > best) {
+                    best = score;
+                    if (bestMove) *bestMove = cell;
+                }
+                alpha = std::max(alpha, score);
+                if (alpha >= beta) break;
+            }
+            return best;
+        }
+    };
+
+}
+
+#endif // MNK_ENGINE_HPP
@@ -0,0 +1,36 @@
+#ifndef CORE_RNG_HPP
+#define CORE_RNG_HPP
+
+#include <cstdint>
+
+namespace core {
+
+    // Small copyable PRNG (splitmix64) so headless runs are reproducible from a seed
+    struct Rng {
+        using result_type = uint64_t;
+
+        uint64_t state;
+
+        explicit Rng(uint64_t seed = 0) : state(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // Uniform integer in [0, n)
+        uint32_t below(uint32_t n) {
+            return static_cast<uint32_t>(((next() >> 32) * n) >> 32);
+        }
+
+        // UniformRandomBitGenerator interface for std::shuffle
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT64_MAX; }
+        result_type operator()() { return next(); }
+    };
+
+}
+
+#endif // CORE_RNG_HPP
@@ -0,0 +1,330 @@
+#include "snake_autopilot.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace core {
+
+    void SnakeAutopilot::prepare(const SnakeGame& game) {
+        if (game.cols == cols && game.rows == rows) return;
+        cols = game.cols;
+        rows = game.rows;
+        int cells = cols * rows;
+        wall.assign(cells, 0);
+        for (int y = 0; y < rows; ++y)
+            for (int x = 0; x < cols; ++x)
+                wall[y * cols + x] = game.isDeadly(SnakeSegment(x, y));
+        vacate.assign(cells, 0);
+        dist.assign(cells, 0);
+        parent.assign(cells, -1);
+        seen.assign(cells, 0);
+        stamp = 0;
+        buildCycle();
+    }
+
+    bool SnakeAutopilot::hasCycle(const SnakeGame& game) {
+        prepare(game);
+        return !cycleNext.empty();
+    }
+
+    void SnakeAutopilot::nextStamp() {
+        if (++stamp == 0) {
+            std::fill(seen.begin(), seen.end(), 0);
+            stamp = 1;
+        }
+    }
+
+    int SnakeAutopilot::neighbour(int cell, Direction d) const {
+        int x = cell % cols, y = cell / cols;
+        switch (d) {
+        case UP:    --y; break;
+        case DOWN:  ++y; break;
+        case LEFT:  --x; break;
+        case RIGHT: ++x; break;
+        }
+        if (x < 0 || x >= cols || y < 0 || y >= rows) return -1;
+        return y * cols + x;
+    }
+
+    Direction SnakeAutopilot::directionTo(int from, int to) const {
+        if (to == from - cols) return UP;
+        if (to == from + cols) return DOWN;
+        if (to == from - 1) return LEFT;
+        return RIGHT;
+    }
+
+    // Segment i of an n-long body leaves its cell on move n - i, later while still growing
+    void SnakeAutopilot::markBody(const std::vector<int>& cells, int growth) {
+        int n = static_cast<int>(cells.size());
+        for (int i = 0; i < n; ++i)
+            vacate[cells[i]] = n - i + growth;
+    }
+
+    void SnakeAutopilot::clearBody(const std::vector<int>& cells) {
+        for (int c : cells)
+            vacate[c] = 0;
+    }
+
+    void SnakeAutopilot::loadBody(const SnakeGame& game) {
+        body.clear();
+        for (const SnakeSegment& s : game.snake.segments)
+            body.push_back(s.y * cols + s.x);
+    }
+
+    // A* with a Manhattan heuristic; a cell can be entered on move t once vacate <= t
+    bool SnakeAutopilot::findPath(int from, int to, int neck) {
+        nextStamp();
+        heap.clear();
+        int tx = to % cols, ty = to / cols;
+        auto h = [&](int c) { return std::abs(c % cols - tx) + std::abs(c / cols - ty); };
+
+        seen[from] = stamp;
+        dist[from] = 0;
+        parent[from] = -1;
+        heap.push_back(std::make_pair(h(from), from));
+        const std::greater<std::pair<int, int>> cmp;
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), cmp);
+            std::pair<int, int> top = heap.back();
+            heap.pop_back();
+            int cur = top.second;
+            if (top.first - h(cur) != dist[cur]) continue;  // stale entry
+            if (cur == to) {
+                path.clear();
+                for (int c = to; c != from; c = parent[c])
+                    path.push_back(c);
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+            int g = dist[cur] + 1;
+            for (int d = 0; d < 4; ++d) {
+                int n = neighbour(cur, static_cast<Direction>(d));
+                if (n < 0 || wall[n] || vacate[n] > g) continue;
+                if (cur == from && n == neck) continue;
+                if (seen[n] == stamp && dist[n] <= g) continue;
+                seen[n] = stamp;
+                dist[n] = g;
+                parent[n] = cur;
+                heap.push_back(std::make_pair(g + h(n), n));
+                std::push_heap(heap.begin(), heap.end(), cmp);
+            }
+        }
+        return false;
+    }
+
+    // Breadth-first moves from the head to the tail's cell, -1 when it cannot be reached
+    int SnakeAutopilot::distanceToTail(int from, int neck, int tail) {
+        nextStamp();
+        queue.clear();
+        queue.push_back(from);
+        seen[from] = stamp;
+        dist[from] = 0;
+        for (size_t qi = 0; qi < queue.size(); ++qi) {
+            int cur = queue[qi];
+            int g = dist[cur] + 1;
+            for (int d = 0; d < 4; ++d) {
+                int n = neighbour(cur, static_cast<Direction>(d));
+                if (n < 0 || wall[n] || seen[n] == stamp || vacate[n] > g) continue;
+                if (cur == from && n == neck) continue;
+                if (n == tail) return g;
+                seen[n] = stamp;
+                dist[n] = g;
+                queue.push_back(n);
+            }
+        }
+        return -1;
+    }
+
+    // Replays the path on a copy of the body and measures how far the head is from the tail
+    int SnakeAutopilot::tailDistanceAfter(const std::vector<int>& steps, int growth, bool eats) {
+        int moves = static_cast<int>(steps.size());
+        int length = static_cast<int>(body.size()) + std::min(moves, growth);
+        int pending = std::max(0, growth - moves) + (eats ? 1 : 0);
+
+        virtualBody.assign(steps.rbegin(), steps.rend());
+        for (int i = 0; static_cast<int>(virtualBody.size()) < length; ++i)
+            virtualBody.push_back(body[i]);
+
+        // too short to trap itself
+        if (length < 3) return 1;
+
+        clearBody(body);
+        markBody(virtualBody, pending);
+        int result = distanceToTail(virtualBody[0], virtualBody[1], virtualBody.back());
+        clearBody(virtualBody);
+        markBody(body, growth);
+        return result;
+    }
+
+    int SnakeAutopilot::reachableArea(int from) {
+        nextStamp();
+        queue.clear();
+        queue.push_back(from);
+        seen[from] = stamp;
+        dist[from] = 1;
+        for (size_t qi = 0; qi < queue.size(); ++qi) {
+            int cur = queue[qi];
+            int g = dist[cur] + 1;
+            for (int d = 0; d < 4; ++d) {
+                int n = neighbour(cur, static_cast<Direction>(d));
+                if (n < 0 || wall[n] || seen[n] == stamp || vacate[n] > g) continue;
+                seen[n] = stamp;
+                dist[n] = g;
+                queue.push_back(n);
+            }
+        }
+        return static_cast<int>(queue.size());
+    }
+
+    // Boustrophedon cycle: the first row of the playfield is the way back, the remaining
+    // rows are swept column by column. Needs an even number of columns, otherwise the
+    // same sweep runs on the transposed field; a field odd both ways has no cycle.
+    void SnakeAutopilot::buildCycle() {
+        cycleNext.clear();
+        int minX = cols, maxX = -1, minY = rows, maxY = -1;
+        for (int y = 0; y < rows; ++y)
+            for (int x = 0; x < cols; ++x)
+                if (!wall[y * cols + x]) {
+                    minX = std::min(minX, x); maxX = std::max(maxX, x);
+                    minY = std::min(minY, y); maxY = std::max(maxY, y);
+                }
+        int w = maxX - minX + 1, h = maxY - minY + 1;
+        if (w < 2 || h < 2) return;
+        bool transpose = (w % 2 != 0);
+        if (transpose && h % 2 != 0) return;
+
+        int uSize = transpose ? h : w, vSize = transpose ? w : h;
+        auto cell = [&](int u, int v) {
+            return transpose ? (minY + u) * cols + (minX + v) : (minY + v) * cols + (minX + u);
+        };
+
+        cycleNext.assign(cols * rows, -1);
+        for (int u = 0; u < uSize; ++u) {
+            for (int v = 0; v < vSize; ++v) {
+                int next;
+                if (v == 0)
+                    next = (u > 0) ? cell(u - 1, 0) : cell(0, 1);
+                else if (u % 2 == 0)
+                    next = (v < vSize - 1) ? cell(u, v + 1) : cell(u + 1, v);
+                else if (v > 1)
+                    next = cell(u, v - 1);
+                else
+                    next = (u == uSize - 1) ? cell(u, 0) : cell(u + 1, v);
+                cycleNext[cell(u, v)] = next;
+            }
+        }
+
+        cycleLength = uSize * vSize;
+        cycleOrder.assign(cols * rows, -1);
+        int c = cell(0, 0);
+        for (int i = 0; i < cycleLength; ++i, c = cycleNext[c])
+            cycleOrder[c] = i;
+    }
+
+    int SnakeAutopilot::cycleDistance(int from, int to) const {
+        int d = cycleOrder[to] - cycleOrder[from];
+        return d < 0 ? d + cycleLength : d;
+    }
+
+    // True while the whole body lies on the stretch of the cycle from the tail up to
+    // the head. Everything past the head is then free all the way round to the tail.
+    bool SnakeAutopilot::alongCycle() const {
+        if (cycleNext.empty()) return false;
+        int tail = body.back();
+        int span = cycleDistance(tail, body[0]);
+        for (int c : body)
+            if (cycleDistance(tail, c) > span) return false;
+        return true;
+    }
+
+    // A step that stays short of the tail (with room for any growth) keeps the body on its
+    // stretch; it must not skip past the food either, or the food falls behind the head.
+    // Past half the board only the cycle itself is followed, so skipped cells are
+    // swept up before the free stretch ahead gets short.
+    bool SnakeAutopilot::shortcutAllowed(int n, int food, int growth) const {
+        int ahead = cycleDistance(body[0], n);
+        if (ahead == 1) return true;
+        if (static_cast<int>(body.size()) * 2 > cycleLength) return false;
+        if (food >= 0 && ahead > cycleDistance(body[0], food)) return false;
+        return ahead + growth + (n == food ? 1 : 0) < cycleDistance(body[0], body.back());
+    }
+
+    Direction SnakeAutopilot::decide(const SnakeGame& game) {
+        const Snake& snake = game.snake;
+        if (game.gameOver || snake.segments.empty()) return snake.dir;
+
+        prepare(game);
+        loadBody(game);
+        int growth = snake.pendingMoves();
+        markBody(body, growth);
+
+        int head = body[0];
+        int neck = body.size() > 1 ? body[1] : -1;
+        int food = game.food.x >= 0 ? game.food.y * cols + game.food.x : -1;
+        bool hasPath = food >= 0 && findPath(head, food, neck);
+        Direction choice = snake.dir;
+        bool chosen = false;
+
+        if (alongCycle()) {
+            // Cycle mode: the A* step when it is a legal shortcut, otherwise the legal
+            // step that leaves the least of the cycle between the head and the food
+            if (hasPath && vacate[path[0]] == 0 && shortcutAllowed(path[0], food, growth)) {
+                choice = directionTo(head, path[0]);
+                chosen = true;
+            }
+            int best = BLOCKED;
+            for (int d = 0; d < 4 && !chosen; ++d) {
+                int n = neighbour(head, static_cast<Direction>(d));
+                if (n < 0 || wall[n] || n == neck || vacate[n] > 1) continue;
+                if (!shortcutAllowed(n, food, growth)) continue;
+                int left = food >= 0 ? cycleDistance(n, food) : cycleDistance(n, head);
+                if (left < best) {
+                    best = left;
+                    choice = static_cast<Direction>(d);
+                }
+            }
+            chosen = chosen || best != BLOCKED;
+        }
+
+        // 1. Shortest path to the food, if the tail can still be reached afterwards
+        if (!chosen && hasPath && tailDistanceAfter(path, growth, true) >= 0) {
+            choice = directionTo(head, path[0]);
+            chosen = true;
+        }
+
+        // 2. Tail following: the safe step that leaves the tail furthest away
+        if (!chosen) {
+            int best = -1;
+            for (int d = 0; d < 4; ++d) {
+                int n = neighbour(head, static_cast<Direction>(d));
+                if (n < 0 || wall[n] || n == neck || vacate[n] > 1) continue;
+                path.assign(1, n);
+                int reach = tailDistanceAfter(path, growth, n == food);
+                if (reach > best) {
+                    best = reach;
+                    choice = static_cast<Direction>(d);
+                    chosen = true;
+                }
+            }
+        }
+
+        // 3. Whichever step opens onto the most room
+        if (!chosen) {
+            int best = 0;
+            for (int d = 0; d < 4; ++d) {
+                int n = neighbour(head, static_cast<Direction>(d));
+                if (n < 0 || wall[n] || n == neck || vacate[n] > 1) continue;
+                int area = reachableArea(n);
+                if (area > best) {
+                    best = area;
+                    choice = static_cast<Direction>(d);
+                }
+            }
+        }
+
+        clearBody(body);
+        return choice;
+    }
+
+}
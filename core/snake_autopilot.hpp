@@ -0,0 +1,64 @@
+#ifndef SNAKE_AUTOPILOT_HPP
+#define SNAKE_AUTOPILOT_HPP
+
+#include "snake_core.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace core {
+
+    // Computer driver for SnakeGame.
+    // When the playfield has a Hamiltonian cycle and the body lies along it, the snake
+    // follows the cycle and only takes the A* step towards the food (or another shortcut)
+    // when it cannot overtake its own tail, which can never trap it. Otherwise it tries:
+    //  1. an A* path to the food, taken only if the tail is still reachable once it is eaten
+    //  2. the safe neighbour that keeps the tail furthest away (tail following)
+    //  3. the neighbour that opens onto the most room
+    // Body cells count as passable from the move on which the tail will have left them,
+    // so paths may run through the body as it drains away. Buffers are reused between calls.
+    // A playfield odd in both directions has no Hamiltonian cycle, and there the fallback
+    // can follow its tail for ever without eating; only boards with a cycle are sure to end.
+    class SnakeAutopilot {
+    public:
+        Direction decide(const SnakeGame& game);
+        // True when the game's playfield has the cycle the autopilot relies on
+        bool hasCycle(const SnakeGame& game);
+
+    private:
+        static const int BLOCKED = 1 << 30;
+
+        void prepare(const SnakeGame& game);
+        void loadBody(const SnakeGame& game);
+        void markBody(const std::vector<int>& cells, int growth);
+        void clearBody(const std::vector<int>& cells);
+        bool findPath(int from, int to, int neck);
+        int distanceToTail(int from, int neck, int tail);
+        int tailDistanceAfter(const std::vector<int>& steps, int growth, bool eats);
+        int reachableArea(int from);
+        void buildCycle();
+        int cycleDistance(int from, int to) const;
+        bool alongCycle() const;
+        bool shortcutAllowed(int n, int food, int growth) const;
+        int neighbour(int cell, Direction d) const;
+        Direction directionTo(int from, int to) const;
+        void nextStamp();
+
+        int cols = 0, rows = 0;
+        std::vector<uint8_t> wall;
+        std::vector<int> vacate;        // move on which a cell becomes free, 0 when already free
+        std::vector<int> body;          // head..tail as cell ids
+        std::vector<int> virtualBody;
+        std::vector<int> path;          // cells after the head, food last
+        std::vector<int> cycleNext;     // empty when the playfield has no Hamiltonian cycle
+        std::vector<int> cycleOrder;    // position of each cell along the cycle
+        int cycleLength = 0;
+        std::vector<int> dist, parent;
+        std::vector<uint32_t> seen;
+        uint32_t stamp = 0;
+        std::vector<int> queue;
+        std::vector<std::pair<int, int>> heap;
+    };
+
+}
+
+#endif // SNAKE_AUTOPILOT_HPP
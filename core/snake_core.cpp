@@ -0,0 +1,264 @@
+#include "snake_core.hpp"
+#include "snake_autopilot.hpp"
+#include <algorithm>
+
+SnakeSegment::SnakeSegment(int x, int y) : x(x), y(y) {}
+
+void SnakeBody::init(int capacity) {
+    cells.assign(capacity, SnakeSegment());
+    this->capacity = capacity;
+    head = 0;
+    length = 0;
+}
+
+void SnakeBody::pushFront(const SnakeSegment& s) {
+    head = (head == 0 ? capacity : head) - 1;
+    cells[head] = s;
+    ++length;
+}
+
+void SnakeBody::popBack() {
+    --length;
+}
+
+Snake::Snake(int cols, int rows)
+    : cols(cols), rows(rows), occupied((cols * rows + 63) / 64, 0), pendingGrowth(0), collided(false),
+      lastTail(10, 10), lastMoveGrew(true) {
+    // one spare slot so the new head can be pushed before the tail is dropped
+    segments.init(cols * rows + 1);
+    segments.pushFront(SnakeSegment(10, 10));
+    setCell(10, 10, true);
+    dir = RIGHT;
+}
+
+void Snake::setCell(int x, int y, bool on) {
+    if (!inField(x, y)) return;
+    int bit = y * cols + x;
+    if (on) occupied[bit >> 6] |= uint64_t(1) << (bit & 63);
+    else    occupied[bit >> 6] &= ~(uint64_t(1) << (bit & 63));
+}
+
+bool Snake::occupies(int x, int y) const {
+    if (!inField(x, y)) return false;
+    int bit = y * cols + x;
+    return (occupied[bit >> 6] >> (bit & 63)) & 1;
+}
+
+void Snake::move() {
+    SnakeSegment next = segments.front();
+    switch (dir) {
+    case UP:    next.y -= 1; break;
+    case DOWN:  next.y += 1; break;
+    case LEFT:  next.x -= 1; break;
+    case RIGHT: next.x += 1; break;
+    }
+
+    // The tail leaves its cell before the head arrives, so chasing the tail is safe
+    lastMoveGrew = pendingGrowth > 0;
+    if (lastMoveGrew) {
+        --pendingGrowth;
+    } else {
+        const SnakeSegment& tail = segments.back();
+        lastTail = tail;
+        setCell(tail.x, tail.y, false);
+        segments.popBack();
+    }
+
+    collided = occupies(next.x, next.y);
+    segments.pushFront(next);
+    setCell(next.x, next.y, true);
+}
+
+void Snake::grow() {
+    ++pendingGrowth;
+}
+
+// Every segment steps into the cell of the one ahead of it; only the tail
+// needs remembering, and it stays put on a move that grew the body
+SnakeSegment Snake::previous(int i) const {
+    if (i + 1 < static_cast<int>(segments.size()))
+        return segments[i + 1];
+    return lastMoveGrew ? segments[i] : lastTail;
+}
+
+bool Snake::checkCollision() const {
+    return collided;
+}
+
+void Snake::setDirection(Direction d) {
+    if ((dir == UP && d != DOWN) || (dir == DOWN && d != UP) ||
+        (dir == LEFT && d != RIGHT) || (dir == RIGHT && d != LEFT))
+        dir = d;
+}
+
+namespace core {
+
+    void FreeCells::init(int cellCount) {
+        cells.clear();
+        cells.reserve(cellCount);
+        slot.assign(cellCount, -1);
+    }
+
+    void FreeCells::insert(int cell) {
+        if (slot[cell] >= 0) return;
+        slot[cell] = static_cast<int>(cells.size());
+        cells.push_back(cell);
+    }
+
+    // Swap the last id into the erased slot
+    void FreeCells::erase(int cell) {
+        int i = slot[cell];
+        if (i < 0) return;
+        int last = cells.back();
+        cells[i] = last;
+        slot[last] = i;
+        cells.pop_back();
+        slot[cell] = -1;
+    }
+
+    SnakeGame::SnakeGame(int cols, int rows) : cols(cols), rows(rows) {
+        reset(0);
+    }
+
+    void SnakeGame::reset(uint32_t seed) {
+        rng = Rng(seed);
+        snake = Snake(cols, rows);
+        booster = GridPos{ -1, -1 };
+        speedBoosterActive = false;
+        pointBoosterActive = false;
+        useSpeedBoosterNext = true; // alternate boosters
+        score = 0;
+        speedLevel = 0;
+        won = false;
+        baseSpeed = 0.2f;
+        moveTimer = 0.f;
+        gameOver = false;
+
+        freeCells.init(cols * rows);
+        for (int y = 0; y < rows; ++y)
+            for (int x = 0; x < cols; ++x)
+                if (inSpawnArea(x, y) && !snake.occupies(x, y))
+                    freeCells.insert(y * cols + x);
+        food = spawnPosition();
+    }
+
+    void SnakeGame::apply(Direction d) {
+        if (!gameOver)
+            snake.setDirection(d);
+    }
+
+    float SnakeGame::currentSpeed() const {
+        return std::max(0.05f, baseSpeed - 0.02f * speedLevel);
+    }
+
+    int SnakeGame::step(float dt) {
+        if (gameOver) return SNAKE_NONE;
+        moveTimer += dt;
+
+        int events = SNAKE_NONE;
+        int ticks = 0;
+        while (moveTimer >= currentSpeed() && !gameOver) {
+            if (ticks == MAX_CATCH_UP_TICKS) {
+                moveTimer = 0.f;
+                break;
+            }
+            moveTimer -= currentSpeed();
+            if (autopilot)
+                apply(autopilot->decide(*this));
+            events |= tick();
+            ++ticks;
+        }
+        return events;
+    }
+
+    float SnakeGame::interpolation() const {
+        if (gameOver) return 1.f;
+        return std::min(1.f, moveTimer / currentSpeed());
+    }
+
+    bool SnakeGame::isDeadly(const SnakeSegment& head) const {
+        return head.x < 2 || head.x >= cols - 2 || head.y < 2 || head.y >= rows - 2;
+    }
+
+    // Food and boosters stay inside the live area, clear of the top border row
+    bool SnakeGame::inSpawnArea(int x, int y) const {
+        return x >= 2 && x < cols - 2 && y >= 3 && y < rows - 2;
+    }
+
+    void SnakeGame::markFree(int x, int y) {
+        if (inSpawnArea(x, y)) freeCells.insert(y * cols + x);
+    }
+
+    void SnakeGame::markUsed(int x, int y) {
+        if (inSpawnArea(x, y)) freeCells.erase(y * cols + x);
+    }
+
+    GridPos SnakeGame::spawnPosition() {
+        if (freeCells.empty()) return GridPos{ -1, -1 };
+        int cell = freeCells.sample(rng);
+        freeCells.erase(cell);
+        return GridPos{ cell % cols, cell / cols };
+    }
+
+    int SnakeGame::tick() {
+        if (gameOver) return SNAKE_NONE;
+
+        int events = SNAKE_NONE;
+        SnakeSegment tail = snake.segments.back();
+        std::size_t length = snake.segments.size();
+        snake.move();
+        const SnakeSegment& head = snake.segments.front();
+
+        if (isDeadly(head) || snake.checkCollision()) {
+            gameOver = true;
+            return SNAKE_DIED;
+        }
+
+        // The cell the tail left opens up before the head's cell is taken
+        if (snake.segments.size() == length)
+            markFree(tail.x, tail.y);
+        markUsed(head.x, head.y);
+
+        // Food collision
+        if (head.x == food.x && head.y == food.y) {
+            snake.grow();
+            score++;
+            events |= SNAKE_ATE;
+            food = spawnPosition();
+
+            if (food.x == -1) {
+                won = gameOver = true;
+                return events | SNAKE_WON;
+            }
+
+            // Check for booster spawn; an uncollected booster moves
+            if (score % BOOSTER_INTERVAL == 0) {
+                if (booster.x != -1)
+                    markFree(booster.x, booster.y);
+                booster = spawnPosition();
+                if (booster.x != -1) {
+                    speedBoosterActive = useSpeedBoosterNext;
+                    pointBoosterActive = !useSpeedBoosterNext;
+                    useSpeedBoosterNext = !useSpeedBoosterNext;
+                }
+            }
+
+            if (score % SPEED_INCREASE_INTERVAL == 0 && speedLevel < MAX_SPEED_LEVEL)
+                speedLevel++;
+        }
+
+        // Booster collision
+        const SnakeSegment& newHead = snake.segments.front();
+        if (booster.x == newHead.x && booster.y == newHead.y) {
+            if (speedBoosterActive && speedLevel < MAX_SPEED_LEVEL)
+                speedLevel++;
+            if (pointBoosterActive) score += 5;
+            booster = GridPos{ -1, -1 };
+            speedBoosterActive = pointBoosterActive = false;
+            events |= SNAKE_BOOSTER;
+        }
+
+        return events;
+    }
+
+}
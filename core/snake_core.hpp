@@ -0,0 +1,163 @@
+#ifndef SNAKE_CORE_HPP
+#define SNAKE_CORE_HPP
+
+#include "rng.hpp"
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <cstdint>
+
+enum Direction { UP, DOWN, LEFT, RIGHT };
+
+struct SnakeSegment {
+    int x, y;
+    SnakeSegment(int x = 0, int y = 0);
+};
+
+// Fixed-capacity ring buffer of body cells, index 0 is the head.
+// Iterates head to tail like the vector it replaces.
+class SnakeBody {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = SnakeSegment;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const SnakeSegment*;
+        using reference = const SnakeSegment&;
+
+        const_iterator(const SnakeBody* body, int i) : body(body), i(i) {}
+        const SnakeSegment& operator*() const { return (*body)[i]; }
+        const SnakeSegment* operator->() const { return &(*body)[i]; }
+        const_iterator& operator++() { ++i; return *this; }
+        bool operator!=(const const_iterator& o) const { return i != o.i; }
+        bool operator==(const const_iterator& o) const { return i == o.i; }
+    private:
+        const SnakeBody* body;
+        int i;
+    };
+
+    void init(int capacity);
+    void pushFront(const SnakeSegment& s);
+    void popBack();
+
+    const SnakeSegment& operator[](int i) const { return cells[wrap(head + i)]; }
+    const SnakeSegment& front() const { return cells[head]; }
+    const SnakeSegment& back() const { return cells[wrap(head + length - 1)]; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, length); }
+
+private:
+    int wrap(int i) const { return i >= capacity ? i - capacity : i; }
+
+    std::vector<SnakeSegment> cells;
+    int capacity = 0;
+    int head = 0;
+    int length = 0;
+};
+
+// The body plus a bit-per-cell occupancy grid of the field, so moving,
+// growing and self-collision cost the same at any length
+class Snake {
+public:
+    Snake(int cols = 40, int rows = 30);
+    void move();
+    void grow();                    // the tail stays put on the next move
+    bool checkCollision() const;    // did the last move run into the body?
+    void setDirection(Direction d);
+    bool occupies(int x, int y) const;
+    SnakeSegment previous(int i) const;    // where segment i was before the last move
+    int pendingMoves() const { return pendingGrowth; }    // moves left before the tail moves again
+
+    SnakeBody segments;
+    Direction dir;
+
+private:
+    bool inField(int x, int y) const { return x >= 0 && x < cols && y >= 0 && y < rows; }
+    void setCell(int x, int y, bool on);
+
+    int cols, rows;
+    std::vector<uint64_t> occupied;
+    int pendingGrowth;
+    bool collided;
+    SnakeSegment lastTail;      // cell dropped by the last move
+    bool lastMoveGrew;
+};
+
+namespace core {
+
+    class SnakeAutopilot;
+
+    struct GridPos {
+        int x, y;
+    };
+
+    // Flags returned by SnakeGame::step/tick
+    enum SnakeEvent { SNAKE_NONE = 0, SNAKE_ATE = 1, SNAKE_BOOSTER = 2, SNAKE_DIED = 4, SNAKE_WON = 8 };
+
+    // Set of grid cells with O(1) insert, erase and uniform sampling:
+    // a dense array of cell ids plus each id's slot in it (-1 when absent)
+    class FreeCells {
+    public:
+        void init(int cellCount);
+        void insert(int cell);
+        void erase(int cell);
+        bool contains(int cell) const { return slot[cell] >= 0; }
+        bool empty() const { return cells.empty(); }
+        std::size_t size() const { return cells.size(); }
+        int sample(Rng& rng) const { return cells[rng.below(static_cast<uint32_t>(cells.size()))]; }
+
+    private:
+        std::vector<int> cells;
+        std::vector<int> slot;
+    };
+
+    class SnakeGame {
+    public:
+        static const int SPEED_INCREASE_INTERVAL = 3;
+        static const int MAX_SPEED_LEVEL = 5;
+        static const int BOOSTER_INTERVAL = 10;
+        static const int MAX_CATCH_UP_TICKS = 5;  // per step(); the rest of a long stall is dropped
+
+        // cols/rows is the whole grid; the outer two cells on each side are walls and UI
+        SnakeGame(int cols = 40, int rows = 30);
+
+        void reset(uint32_t seed);
+        void apply(Direction d);
+        int step(float dt);     // fixed timestep: runs every tick owed by dt, events OR-ed together
+        int tick();             // a single simulation step
+        float currentSpeed() const;
+        float interpolation() const;    // 0..1 progress towards the next tick, for rendering
+        bool isDeadly(const SnakeSegment& head) const;      // outside the walls
+        void setAutopilot(SnakeAutopilot* pilot) { autopilot = pilot; }
+
+        int cols, rows;
+        Snake snake;
+        GridPos food;
+        GridPos booster;        // (-1, -1) when no booster is on the board
+        bool speedBoosterActive;
+        bool pointBoosterActive;
+        bool useSpeedBoosterNext;
+        int score;
+        int speedLevel;
+        bool won;               // the snake left no room for more food
+        float baseSpeed;
+        float moveTimer;        // time accumulated towards the next tick
+        bool gameOver;
+
+    private:
+        bool inSpawnArea(int x, int y) const;
+        void markFree(int x, int y);
+        void markUsed(int x, int y);
+        GridPos spawnPosition();    // (-1, -1) when the board is full
+
+        SnakeAutopilot* autopilot = nullptr;    // steers before every tick when set
+        FreeCells freeCells;    // spawn-area cells not covered by the snake, food or booster
+        Rng rng;
+    };
+
+}
+
+#endif // SNAKE_CORE_HPP
@@ -0,0 +1,55 @@
+#include "tictactoe_core.hpp"
+
+namespace core {
+
+    TicTacToeGame::TicTacToeGame() {
+        reset();
+    }
+
+    void TicTacToeGame::reset(uint32_t) {
+        char num = '1';
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                board[i][j] = num++;
+        currentPlayer = 'X';
+        winner = 0;
+        gameOver = false;
+    }
+
+    bool TicTacToeGame::apply(int row, int col) {
+        if (gameOver || row < 0 || row >= 3 || col < 0 || col >= 3 || !isFree(row, col))
+            return false;
+
+        board[row][col] = currentPlayer;
+        if (isWinner(currentPlayer)) {
+            winner = currentPlayer;
+            gameOver = true;
+        }
+        else if (isDraw()) {
+            gameOver = true;
+        }
+        else {
+            currentPlayer = (currentPlayer == 'X') ? 'O' : 'X';
+        }
+        return true;
+    }
+
+    bool TicTacToeGame::isWinner(char symbol) const {
+        for (int i = 0; i < 3; i++)
+            if ((board[i][0] == symbol && board[i][1] == symbol && board[i][2] == symbol) ||
+                (board[0][i] == symbol && board[1][i] == symbol && board[2][i] == symbol))
+                return true;
+
+        return (board[0][0] == symbol && board[1][1] == symbol && board[2][2] == symbol) ||
+            (board[0][2] == symbol && board[1][1] == symbol && board[2][0] == symbol);
+    }
+
+    bool TicTacToeGame::isDraw() const {
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                if (isFree(i, j))
+                    return false;
+        return true;
+    }
+
+}
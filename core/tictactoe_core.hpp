@@ -0,0 +1,28 @@
+#ifndef TICTACTOE_CORE_HPP
+#define TICTACTOE_CORE_HPP
+
+#include <cstdint>
+
+namespace core {
+
+    class TicTacToeGame {
+    public:
+        TicTacToeGame();
+
+        void reset(uint32_t seed = 0);
+        bool apply(int row, int col);   // marks the cell for the side to move, false if taken
+        void step(float) {}
+
+        bool isWinner(char symbol) const;
+        bool isDraw() const;
+        bool isFree(int row, int col) const { return board[row][col] != 'X' && board[row][col] != 'O'; }
+
+        char board[3][3];               // '1'..'9' for empty cells, 'X' or 'O' when taken
+        char currentPlayer;
+        char winner;                    // 0 while playing or on a draw
+        bool gameOver;
+    };
+
+}
+
+#endif // TICTACTOE_CORE_HPP
@@ -0,0 +1,208 @@
+#include "tictactoe_solver.hpp"
+#include <cstdint>
+
+namespace core {
+
+    namespace {
+
+        // Positions are base-3 codes, sum of piece * 3^cell with X = 1 and O = 2
+        constexpr int CODES = 19683;
+        constexpr int REACHABLE = 5478;
+        constexpr int CANONICAL = 765;     // reachable positions left after folding the 8 symmetries
+        constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+        constexpr int pow3[9] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+        constexpr int lines[8] = { 0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124 };
+
+        // symmetries[s][cell] is where `cell` lands under symmetry s
+        constexpr int symmetries[8][9] = {
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8 },  // identity
+            { 2, 5, 8, 1, 4, 7, 0, 3, 6 },  // rotate 90
+            { 8, 7, 6, 5, 4, 3, 2, 1, 0 },  // rotate 180
+            { 6, 3, 0, 7, 4, 1, 8, 5, 2 },  // rotate 270
+            { 2, 1, 0, 5, 4, 3, 8, 7, 6 },  // mirror columns
+            { 6, 7, 8, 3, 4, 5, 0, 1, 2 },  // mirror rows
+            { 0, 3, 6, 1, 4, 7, 2, 5, 8 },  // main diagonal
+            { 8, 5, 2, 7, 4, 1, 6, 3, 0 },  // anti diagonal
+        };
+
+        struct Entry {
+            int8_t scores[9];       // in canonical orientation
+        };
+
+        struct SolvedTable {
+            Entry entries[CANONICAL];
+            uint16_t slot[CODES];   // entry index * 8 + symmetry taking the position to canonical
+            int canonicalCount;
+            int reachableCount;
+        };
+
+        constexpr bool hasLine(int mask) {
+            for (int line : lines)
+                if ((mask & line) == line) return true;
+            return false;
+        }
+
+        constexpr int transformCode(int code, int s) {
+            int out = 0;
+            for (int cell = 0; cell < 9; ++cell)
+                out += (code / pow3[cell] % 3) * pow3[symmetries[s][cell]];
+            return out;
+        }
+
+        struct Solver {
+            int8_t value[CODES] = {};       // for the side to move
+            int8_t scores[CODES][9] = {};
+            bool visited[CODES] = {};
+            int order[REACHABLE] = {};
+            int count = 0;
+
+            // x and o are bitmasks of the pieces; X moves when the counts are equal
+            constexpr int solve(int code, int x, int o, int pieces) {
+                if (visited[code]) return value[code];
+                visited[code] = true;
+                order[count++] = code;
+
+                int best = TicTacToeSolver::ILLEGAL;
+                bool xToMove = (pieces % 2) == 0;
+                for (int cell = 0; cell < 9; ++cell) {
+                    scores[code][cell] = TicTacToeSolver::ILLEGAL;
+                    int bit = 1 << cell;
+                    if ((x | o) & bit) continue;
+
+                    int score = 0;
+                    int nx = xToMove ? x | bit : x;
+                    int no = xToMove ? o : o | bit;
+                    int child = code + pow3[cell] * (xToMove ? 1 : 2);
+                    if (hasLine(xToMove ? nx : no)) {
+                        score = 10 - (pieces + 1);
+                        if (!visited[child]) {
+                            visited[child] = true;
+                            order[count++] = child;
+                            value[child] = static_cast<int8_t>(-score);
+                            for (int c = 0; c < 9; ++c) scores[child][c] = TicTacToeSolver::ILLEGAL;
+                        }
+                    }
+                    else if (pieces + 1 == 9) {
+                        score = 0;
+                        if (!visited[child]) {
+                            visited[child] = true;
+                            order[count++] = child;
+                            value[child] = 0;
+                            for (int c = 0; c < 9; ++c) scores[child][c] = TicTacToeSolver::ILLEGAL;
+                        }
+                    }
+                    else {
+                        score = -solve(child, nx, no, pieces + 1);
+                    }
+                    scores[code][cell] = static_cast<int8_t>(score);
+                    if (score > best) best = score;
+                }
+                value[code] = static_cast<int8_t>(best);
+                return best;
+            }
+        };
+
+        constexpr SolvedTable buildTable() {
+            Solver solver;
+            solver.solve(0, 0, 0, 0);
+
+            SolvedTable table = {};
+            for (int code = 0; code < CODES; ++code)
+                table.slot[code] = UNREACHABLE;
+
+            int16_t entryOf[CODES] = {};
+            int canonicalOf[REACHABLE] = {};
+            int symmetryOf[REACHABLE] = {};
+            for (int i = 0; i < solver.count; ++i) {
+                int code = solver.order[i];
+                canonicalOf[i] = code;
+                for (int s = 1; s < 8; ++s) {
+                    int t = transformCode(code, s);
+                    if (t < canonicalOf[i]) {
+                        canonicalOf[i] = t;
+                        symmetryOf[i] = s;
+                    }
+                }
+                if (canonicalOf[i] == code) {
+                    int index = table.canonicalCount++;
+                    entryOf[code] = static_cast<int16_t>(index);
+                    for (int cell = 0; cell < 9; ++cell)
+                        table.entries[index].scores[cell] = solver.scores[code][cell];
+                }
+            }
+            for (int i = 0; i < solver.count; ++i)
+                table.slot[solver.order[i]] = static_cast<uint16_t>(entryOf[canonicalOf[i]] * 8 + symmetryOf[i]);
+            table.reachableCount = solver.count;
+            return table;
+        }
+
+        // Roughly a million constexpr steps; MSVC may need /constexpr:steps raised to match
+        constexpr SolvedTable solvedTable = buildTable();
+
+        static_assert(solvedTable.reachableCount == REACHABLE, "every legal position is reachable from the empty board");
+        static_assert(solvedTable.canonicalCount == CANONICAL, "symmetry folding should leave 765 positions");
+
+        int encode(const TicTacToeGame& game) {
+            int code = 0;
+            for (int cell = 0; cell < 9; ++cell) {
+                char c = game.board[cell / 3][cell % 3];
+                if (c == 'X') code += pow3[cell];
+                else if (c == 'O') code += 2 * pow3[cell];
+            }
+            return code;
+        }
+
+    }
+
+    int TicTacToeSolver::positionCount() {
+        return solvedTable.canonicalCount;
+    }
+
+    bool TicTacToeSolver::moveScores(const TicTacToeGame& game, int scores[9]) {
+        uint16_t slot = solvedTable.slot[encode(game)];
+        if (slot == UNREACHABLE) return false;
+
+        const Entry& entry = solvedTable.entries[slot / 8];
+        const int* symmetry = symmetries[slot % 8];
+        for (int cell = 0; cell < 9; ++cell)
+            scores[cell] = entry.scores[symmetry[cell]];
+        return true;
+    }
+
+    int TicTacToeSolver::chooseMove(const TicTacToeGame& game, Difficulty difficulty, Rng& rng) {
+        int scores[9];
+        if (game.gameOver || !moveScores(game, scores)) return -1;
+
+        int best = ILLEGAL;
+        for (int s : scores)
+            if (s > best) best = s;
+        if (best == ILLEGAL) return -1;
+
+        // How often each level ignores the best move, and how bad a move it will accept
+        int slack = 0;
+        switch (difficulty) {
+        case EASY:    slack = rng.below(100) < 60 ? 100 : 0; break;     // often any legal move
+        case MEDIUM:  slack = rng.below(100) < 40 ? 1 : 0; break;       // may miss wins, never blunders a draw
+        case HARD:    slack = 0; break;
+        case PERFECT: slack = 0; break;
+        }
+
+        // HARD plays for the right outcome but not necessarily the quickest win
+        auto outcome = [](int s) { return s > 0 ? 1 : (s < 0 ? -1 : 0); };
+        int candidates[9];
+        int count = 0;
+        for (int cell = 0; cell < 9; ++cell) {
+            int s = scores[cell];
+            if (s == ILLEGAL) continue;
+            bool keep;
+            if (slack >= 100) keep = true;
+            else if (slack > 0) keep = outcome(s) >= (outcome(best) < 0 ? -1 : 0);
+            else if (difficulty == HARD) keep = outcome(s) == outcome(best);
+            else keep = s == best;
+            if (keep) candidates[count++] = cell;
+        }
+        return candidates[rng.below(count)];
+    }
+
+}
@@ -0,0 +1,30 @@
+#ifndef TICTACTOE_SOLVER_HPP
+#define TICTACTOE_SOLVER_HPP
+
+#include "tictactoe_core.hpp"
+#include "rng.hpp"
+
+namespace core {
+
+    // Perfect-play oracle backed by a table of every reachable position, solved at
+    // compile time. Lookups never search: the position code indexes the table directly.
+    class TicTacToeSolver {
+    public:
+        enum Difficulty { EASY, MEDIUM, HARD, PERFECT };
+
+        static const int ILLEGAL = -128;
+
+        // Score of each cell for the side to move: 10 - pieces on a win, 0 for a draw,
+        // negative for a loss, ILLEGAL for occupied cells. Returns false for unreachable boards.
+        static bool moveScores(const TicTacToeGame& game, int scores[9]);
+
+        // Cell index (row * 3 + col) to play, or -1 if the game is over.
+        // Lower difficulties sample deliberately weaker moves from the same table.
+        static int chooseMove(const TicTacToeGame& game, Difficulty difficulty, Rng& rng);
+
+        static int positionCount();     // distinct canonical positions stored
+    };
+
+}
+
+#endif // TICTACTOE_SOLVER_HPP
@@ -7,6 +7,8 @@
 #include "Hangman.hpp"
 #include "Snake.hpp"
 #include "minesweeper.hpp"
+#include "assets.hpp"
+#include "scene.hpp"
 
 struct Button {
     sf::RectangleShape shape;
@@ -20,204 +22,345 @@ struct Button {
         text.setPosition(x + shape.getSize().x / 2.f, y + shape.getSize().y / 2.f);
     }
 
-    bool isMouseOver(sf::RenderWindow& window) {
-        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        return shape.getGlobalBounds().contains(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
+    bool contains(int x, int y) const {
+        return shape.getGlobalBounds().contains(static_cast<float>(x), static_cast<float>(y));
     }
-};
 
-void showScoreMenu(sf::RenderWindow& window, sf::Font& font) {
-    const int buttonWidth = 270;
-    const int buttonHeight = 48;
-    const int buttonSpacing = 15;
-
-    std::vector<Button> scoreButtons(7);
-    std::string scoreLabels[] = {
-        "Tic Tac Toe Scores",
-        "Connect Four Scores",
-        "Memory Match Scores",
-        "Hangman Scores",
-        "Snake Scores",
-        "Mine Sweeper Scores",
-        "Back to Main Menu"
-    };
-
-    for (int i = 0; i < 7; ++i) {
-        scoreButtons[i].shape.setSize(sf::Vector2f(buttonWidth, buttonHeight));
-        scoreButtons[i].shape.setFillColor(sf::Color(180, 180, 20));
-        scoreButtons[i].text.setFont(font);
-        scoreButtons[i].text.setString(scoreLabels[i]);
-        scoreButtons[i].text.setCharacterSize(24);
-        scoreButtons[i].text.setFillColor(sf::Color::Black);
-
-        float x = (window.getSize().x - buttonWidth) / 2.f;
-        float y = 160 + i * (buttonHeight + buttonSpacing);
-        scoreButtons[i].setPosition(x, y);
+    void highlight(bool hovered) {
+        shape.setFillColor(hovered ? sf::Color(100, 100, 250) : sf::Color(180, 180, 180));
+        text.setFillColor(hovered ? sf::Color::White : sf::Color::Black);
     }
+};
 
-    sf::Text heading;
-    heading.setFont(font);
-    heading.setString("GAME SCORES");
-    heading.setCharacterSize(30);
-    heading.setFillColor(sf::Color::White);
-    heading.setStyle(sf::Text::Bold);
-    sf::FloatRect headingBounds = heading.getLocalBounds();
-    heading.setOrigin(headingBounds.left + headingBounds.width / 2.f,
-        headingBounds.top + headingBounds.height / 2.f);
-    heading.setPosition(window.getSize().x / 2.f, 60.f);
-
-    bool inScoreMenu = true;
-    while (inScoreMenu && window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) window.close();
-
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                for (int i = 0; i < 7; ++i) {
-                    if (scoreButtons[i].isMouseOver(window)) {
-                        if (i == 6) return; // Back to main menu
-                        std::string filenames[] = {
-                            "highscores.txt", "connectfour_scores.txt", "memorymatch_scores.txt",
-                            "hangman_scores.txt", "snake_scores.txt", "minesweeper_scores.txt"
-                        };
-
-                        std::ifstream file(filenames[i]);
-                        std::string line, content;
-                        if (file.is_open()) {
-                            while (getline(file, line)) content += line + "\n";
-                            file.close();
-                        }
-                        else {
-                            content = "No scores available.";
-                        }
-
-                        sf::Text scoreText(content, font, 22);
-                        scoreText.setFillColor(sf::Color::White);
-                        scoreText.setPosition(30, 100);
-
-                        sf::RenderWindow scoreWindow(sf::VideoMode(500, 400), scoreLabels[i]);
-                        while (scoreWindow.isOpen()) {
-                            sf::Event e;
-                            while (scoreWindow.pollEvent(e)) {
-                                if (e.type == sf::Event::Closed ||
-                                    (e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::Escape)) {
-                                    scoreWindow.close();
-                                }
-                            }
-                            scoreWindow.clear(sf::Color(0, 0, 60)); // Score window background color
-                            scoreWindow.draw(scoreText);
-                            scoreWindow.display();
-                        }
-                    }
-                }
+void SceneStack::push(std::unique_ptr<Scene> scene) {
+    pending.push_back(Change{ PUSH, std::move(scene) });
+}
+
+void SceneStack::pop() {
+    pending.push_back(Change{ POP, nullptr });
+}
+
+void SceneStack::replace(std::unique_ptr<Scene> scene) {
+    pop();
+    push(std::move(scene));
+}
+
+void SceneStack::clear() {
+    pending.push_back(Change{ CLEAR, nullptr });
+}
+
+bool SceneStack::applyChanges(sf::RenderWindow& window) {
+    if (pending.empty()) return false;
+    Scene* before = scenes.empty() ? nullptr : scenes.back().get();
+
+    // A scene's enter() or exit() may queue more changes; those wait for the next frame
+    std::vector<Change> changes;
+    changes.swap(pending);
+    for (Change& change : changes) {
+        switch (change.type) {
+        case PUSH:
+            if (!change.scene) break;   // the scene could not be built (missing font)
+            change.scene->stack = this;
+            scenes.push_back(std::move(change.scene));
+            break;
+        case POP:
+            if (scenes.empty()) break;
+            scenes.back()->exit();
+            scenes.pop_back();
+            break;
+        case CLEAR:
+            while (!scenes.empty()) {
+                scenes.back()->exit();
+                scenes.pop_back();
             }
+            break;
         }
+    }
 
-        for (auto& btn : scoreButtons) {
-            if (btn.isMouseOver(window)) {
-                btn.shape.setFillColor(sf::Color(100, 100, 250));
-                btn.text.setFillColor(sf::Color::White);
-            }
-            else {
-                btn.shape.setFillColor(sf::Color(180, 180, 180));
-                btn.text.setFillColor(sf::Color::Black);
-            }
+    if (scenes.empty() || scenes.back().get() == before) return false;
+    scenes.back()->enter(window);
+    scenes.back()->redraw();
+    return true;
+}
+
+// SFML 2 has no timed waitEvent. Without a deadline this blocks in waitEvent();
+// with one it polls in short sleeps, so a timer fires at most one slice late.
+bool waitEvent(sf::RenderWindow& window, sf::Event& event, sf::Time timeout) {
+    if (timeout < sf::Time::Zero)
+        return window.waitEvent(event);
+
+    const sf::Time slice = sf::milliseconds(10);
+    sf::Clock waited;
+    while (!window.pollEvent(event)) {
+        sf::Time left = timeout - waited.getElapsedTime();
+        if (left <= sf::Time::Zero) return false;
+        sf::sleep(left < slice ? left : slice);
+    }
+    return true;
+}
+
+void fitWindow(sf::RenderWindow& window, unsigned width, unsigned height, const char* title) {
+    if (window.getSize() != sf::Vector2u(width, height))
+        window.setSize(sf::Vector2u(width, height));
+    window.setView(sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(width), static_cast<float>(height))));
+    window.setTitle(title);
+}
+
+// Column of buttons with hover highlighting, shared by the main and score menus
+class ButtonMenu : public Scene {
+public:
+    ButtonMenu(const sf::Font& font, const std::vector<std::string>& labels, float firstY, unsigned width)
+        : buttons(labels.size()) {
+        const int buttonWidth = 270;
+        const int buttonHeight = 48;
+        const int buttonSpacing = 15;
+
+        for (std::size_t i = 0; i < buttons.size(); ++i) {
+            buttons[i].shape.setSize(sf::Vector2f(buttonWidth, buttonHeight));
+            buttons[i].shape.setFillColor(sf::Color(180, 180, 180));
+            buttons[i].text.setFont(font);
+            buttons[i].text.setString(labels[i]);
+            buttons[i].text.setCharacterSize(24);
+            buttons[i].text.setFillColor(sf::Color::Black);
+
+            float x = (width - buttonWidth) / 2.f;
+            float y = firstY + i * (buttonHeight + buttonSpacing);
+            buttons[i].setPosition(x, y);
         }
+    }
 
-        window.clear(sf::Color(0, 60, 0)); // Different background for score menu
-        window.draw(heading);
-        for (auto& btn : scoreButtons) {
+    void handleEvent(const sf::Event& event) override {
+        if (event.type == sf::Event::MouseMoved) {
+            hover(event.mouseMove.x, event.mouseMove.y);
+        }
+        else if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            for (std::size_t i = 0; i < buttons.size(); ++i)
+                if (buttons[i].contains(event.mouseButton.x, event.mouseButton.y))
+                    clicked(static_cast<int>(i));
+        }
+    }
+
+protected:
+    virtual void clicked(int index) = 0;
+
+    // The pointer may have moved while another scene was up
+    void refreshHover(sf::RenderWindow& window) {
+        sf::Vector2i mouse = sf::Mouse::getPosition(window);
+        hover(mouse.x, mouse.y);
+    }
+
+    void drawButtons(sf::RenderWindow& window) {
+        for (auto& btn : buttons) {
             window.draw(btn.shape);
             window.draw(btn.text);
         }
-        window.display();
     }
-}
+
+private:
+    void hover(int x, int y) {
+        for (auto& btn : buttons)
+            btn.highlight(btn.contains(x, y));
+    }
+
+    std::vector<Button> buttons;
+};
+
+// Plain text dump of a score file
+class ScoreFileScene : public Scene {
+public:
+    ScoreFileScene(const sf::Font& font, const std::string& filename, const std::string& title)
+        : title(title) {
+        std::ifstream file(filename);
+        std::string line, content;
+        if (file.is_open()) {
+            while (getline(file, line)) content += line + "\n";
+            file.close();
+        }
+        else {
+            content = "No scores available.";
+        }
+
+        scoreText = sf::Text(content, font, 22);
+        scoreText.setFillColor(sf::Color::White);
+        scoreText.setPosition(30, 100);
+    }
+
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, 500, 400, title.c_str());
+    }
+
+    void handleEvent(const sf::Event&) override {}
+
+    void render(sf::RenderWindow& window) override {
+        window.clear(sf::Color(0, 0, 60)); // Score window background color
+        window.draw(scoreText);
+    }
+
+private:
+    std::string title;
+    sf::Text scoreText;
+};
+
+class ScoreMenuScene : public ButtonMenu {
+public:
+    explicit ScoreMenuScene(const sf::Font& font)
+        : ButtonMenu(font, labels(), 160, 400), font(font) {
+        heading.setFont(font);
+        heading.setString("GAME SCORES");
+        heading.setCharacterSize(30);
+        heading.setFillColor(sf::Color::White);
+        heading.setStyle(sf::Text::Bold);
+        sf::FloatRect headingBounds = heading.getLocalBounds();
+        heading.setOrigin(headingBounds.left + headingBounds.width / 2.f,
+            headingBounds.top + headingBounds.height / 2.f);
+        heading.setPosition(400 / 2.f, 60.f);
+    }
+
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, 400, 700, "Mini Games Collection");
+        refreshHover(window);
+    }
+
+    void render(sf::RenderWindow& window) override {
+        window.clear(sf::Color(0, 60, 0)); // Different background for score menu
+        window.draw(heading);
+        drawButtons(window);
+    }
+
+private:
+    static std::vector<std::string> labels() {
+        return {
+            "Tic Tac Toe Scores",
+            "Connect Four Scores",
+            "Memory Match Scores",
+            "Hangman Scores",
+            "Snake Scores",
+            "Mine Sweeper Scores",
+            "Back to Main Menu"
+        };
+    }
+
+    void clicked(int index) override {
+        const char* filenames[] = {
+            nullptr, "connectfour_scores.txt", "memorymatch_scores.txt",
+            "hangman_scores.txt", nullptr, "minesweeper_scores.txt"
+        };
+        switch (index) {
+        case 0: scenes().push(makeTicTacToeScoresScene()); break;
+        case 4: scenes().push(makeSnakeScoresScene()); break;
+        case 6: scenes().pop(); break; // Back to main menu
+        default:
+            scenes().push(std::make_unique<ScoreFileScene>(font, filenames[index], labels()[index]));
+            break;
+        }
+    }
+
+    const sf::Font& font;
+    sf::Text heading;
+};
+
+class MainMenuScene : public ButtonMenu {
+public:
+    explicit MainMenuScene(const sf::Font& font)
+        : ButtonMenu(font, { "1. Connect Four", "2. Tic Tac Toe", "3. Memory Match", "4. Hangman",
+              "5. Snake", "6. Mine Sweeper", "View Scores", "Exit" }, 140, 400), font(font) {
+        welcomeText.setFont(font);
+        welcomeText.setString("    WELCOME  \n TO MINI GAME \n  COLLECTION");
+        welcomeText.setCharacterSize(35);
+        welcomeText.setFillColor(sf::Color::White);
+        welcomeText.setStyle(sf::Text::Bold);
+        sf::FloatRect welcomeBounds = welcomeText.getLocalBounds();
+        welcomeText.setOrigin(welcomeBounds.left + welcomeBounds.width / 2.f,
+            welcomeBounds.top + welcomeBounds.height / 2.f);
+        welcomeText.setPosition(400 / 2.f, 60.f);
+    }
+
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, 400, 700, "Mini Games Collection");
+        refreshHover(window);
+    }
+
+    void render(sf::RenderWindow& window) override {
+        window.clear(sf::Color(128, 0, 128));
+        window.draw(welcomeText);
+        drawButtons(window);
+    }
+
+private:
+    void clicked(int index) override {
+        switch (index) {
+        case 0: scenes().push(makeConnectFourScene()); break;
+        case 1: scenes().push(makeTicTacToeScene()); break;
+        case 2: scenes().push(makeMemoryMatchScene()); break;
+        case 3: scenes().push(makeHangmanScene()); break;
+        case 4: scenes().push(makeSnakeScene()); break;
+        case 5: scenes().push(Minesweeper::makeMinesweeperScene()); break;
+        case 6: scenes().push(std::make_unique<ScoreMenuScene>(font)); break;
+        case 7: scenes().clear(); break;
+        }
+    }
+
+    const sf::Font& font;
+    sf::Text welcomeText;
+};
 
 int main() {
+    // Warm up the games' fonts and sounds while the menu is up
+    Assets::preloadGameAssets();
+
     sf::RenderWindow window(sf::VideoMode(400, 700), "Mini Games Collection");
-    sf::Font font;
-    if (!font.loadFromFile("Arial.ttf")) {
+    // Redraws never outrun the display; Snake keeps its own fixed simulation step
+    window.setVerticalSyncEnabled(true);
+    const sf::Font* menuFont = Assets::font("Arial.ttf");
+    if (!menuFont) {
         std::cerr << "Failed to load font\n";
         return 1;
     }
 
-    sf::Text welcomeText;
-    welcomeText.setFont(font);
-    welcomeText.setString("    WELCOME  \n TO MINI GAME \n  COLLECTION");
-    welcomeText.setCharacterSize(35);
-    welcomeText.setFillColor(sf::Color::White);
-    welcomeText.setStyle(sf::Text::Bold);
-    sf::FloatRect welcomeBounds = welcomeText.getLocalBounds();
-    welcomeText.setOrigin(welcomeBounds.left + welcomeBounds.width / 2.f,
-        welcomeBounds.top + welcomeBounds.height / 2.f);
-    welcomeText.setPosition(window.getSize().x / 2.f, 60.f);
-
-    const int buttonWidth = 270;
-    const int buttonHeight = 48;
-    const int buttonSpacing = 15;
-
-    std::vector<Button> buttons(8);
-    std::string labels[] = {
-        "1. Connect Four", "2. Tic Tac Toe", "3. Memory Match", "4. Hangman",
-        "5. Snake", "6. Mine Sweeper", "View Scores", "Exit"
-    };
-
-    for (int i = 0; i < 8; ++i) {
-        buttons[i].shape.setSize(sf::Vector2f(buttonWidth, buttonHeight));
-        buttons[i].shape.setFillColor(sf::Color(180, 180, 180));
-        buttons[i].text.setFont(font);
-        buttons[i].text.setString(labels[i]);
-        buttons[i].text.setCharacterSize(24);
-        buttons[i].text.setFillColor(sf::Color::Black);
-
-        float x = (window.getSize().x - buttonWidth) / 2.f;
-        float y = 140 + i * (buttonHeight + buttonSpacing);
-        buttons[i].setPosition(x, y);
-    }
-
-    while (window.isOpen()) {
+    // One window and one loop for the whole run. Games are pushed over the menu and
+    // popped off again, so switching never recreates the window or its GL context.
+    SceneStack scenes;
+    scenes.push(std::make_unique<MainMenuScene>(*menuFont));
+    scenes.applyChanges(window);
+
+    sf::Clock clock;
+    while (!scenes.empty()) {
+        Scene& scene = scenes.top();
+
+        // A clean scene sleeps until input or its next timer; a dirty one only drains the queue
         sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) window.close();
-
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                for (int i = 0; i < 8; ++i) {
-                    if (buttons[i].isMouseOver(window)) {
-                        switch (i) {
-                        case 0: playConnectFourGame(); break;
-                        case 1: playTicTacToe(); break;
-                        case 2: playMemoryMatch(); break;
-                        case 3: playHangman(); break;
-                        case 4: playSnake(); break;
-                        case 5: Minesweeper::playMinesweeper(); break;
-                        case 6: showScoreMenu(window, font); break;
-                        case 7: window.close(); break;
-                        }
-                    }
-                }
-            }
-        }
+        sf::Time wait = scene.wakeAfter();
+        bool pending = scene.needsRedraw() || wait == sf::Time::Zero
+            ? window.pollEvent(event) : waitEvent(window, event, wait);
 
-        for (auto& btn : buttons) {
-            if (btn.isMouseOver(window)) {
-                btn.shape.setFillColor(sf::Color(100, 100, 250));
-                btn.text.setFillColor(sf::Color::White);
-            }
+        // Stop dispatching once a switch is queued, before polling again: events still
+        // in the queue belong to the next scene
+        while (pending) {
+            if (event.type == sf::Event::Closed)
+                scenes.clear();
+            else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape &&
+                scenes.size() > 1)
+                scenes.pop();   // Esc always leads back towards the main menu
             else {
-                btn.shape.setFillColor(sf::Color(180, 180, 180));
-                btn.text.setFillColor(sf::Color::Black);
+                scene.handleEvent(event);
+                scene.redraw();
             }
+            if (scenes.changing()) break;
+            pending = window.pollEvent(event);
         }
 
-        window.clear(sf::Color(128, 0, 128));
-        window.draw(welcomeText);
-        for (auto& btn : buttons) {
-            window.draw(btn.shape);
-            window.draw(btn.text);
+        if (scenes.applyChanges(window))
+            clock.restart();    // time spent switching is not game time
+        if (scenes.empty()) break;
+
+        Scene& current = scenes.top();
+        current.update(clock.restart().asSeconds());
+        if (current.takeRedraw()) {
+            current.render(window);
+            window.display();
         }
-        window.display();
     }
 
+    window.close();
     return 0;
 }
@@ -1,42 +1,82 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
 #include <SFML/System.hpp>
+#include "core/memorymatch_core.hpp"
+#include "tile_batch.hpp"
+#include "text_cache.hpp"
+#include "alloc_counter.hpp"
+#include "assets.hpp"
+#include "card_deck.hpp"
+#include "MemoryMatch.hpp"
+#include <cstdio>
 #include <iostream>
 #include <vector>
 #include <random>
 #include <ctime>
 #include <algorithm>
+#include <cmath>
 
 using namespace std;
 using namespace sf;
+using core::MemoryMatchGame;
 
-const int gridSize = 4;
-const int totalCards = gridSize * gridSize;
-const float cardSize = 100.f;
-const float spacing = 10.f;
+// Grid sizes picked with the number keys; cards shrink as the grid grows, and grids
+// larger than the window scroll
+struct GridPreset {
+    int rows;
+    int cols;
+    float cardSize;
+};
+const GridPreset GRID_PRESETS[] = {
+    { 4, 4, 100.f },
+    { 6, 6, 80.f },
+    { 8, 8, 64.f },
+    { 16, 16, 48.f },
+    { 32, 32, 48.f },
+};
+const int GRID_PRESET_COUNT = sizeof(GRID_PRESETS) / sizeof(GRID_PRESETS[0]);
 const float offset = 20.f;
+const unsigned MIN_WINDOW = 500;
+const unsigned MAX_WINDOW = 720;
+const float WHEEL_STEP = 60.f;
 
-Font font;
+const Font* font = nullptr;
+TextCache texts;
+
+// Faces come from the images in this directory when it has any, numbers otherwise.
+// The deck is loaded once and shared by every grid size.
+const char* const DECK_DIR = "cards";
+const int MAX_FACES = MemoryMatchGame::MAX_SIDE * MemoryMatchGame::MAX_SIDE / 2;
+// How often a scene checks for newly decoded faces while the deck streams in
+const sf::Time DECK_POLL_INTERVAL = sf::milliseconds(50);
+
+CardDeck& cardDeck() {
+    static CardDeck deck;
+    static const bool loadStarted = deck.load(DECK_DIR, MAX_FACES);
+    (void)loadStarted;      // false just means no deck: numbers are shown
+    return deck;
+}
 
 // ✅ New Overlay: Center Strip for End Message
 void drawOverlay(RenderWindow& window, const string& message) {
     float stripHeight = 120.f;
     float stripY = (window.getSize().y - stripHeight) / 2.f;
 
-    RectangleShape strip(Vector2f(window.getSize().x - 2 * offset, stripHeight));
+    static RectangleShape strip;
+    strip.setSize(Vector2f(window.getSize().x - 2 * offset, stripHeight));
     strip.setPosition(offset, stripY);
     strip.setFillColor(Color(255, 255, 255, 220));  // light opaque strip
     strip.setOutlineThickness(0);  // No border
     window.draw(strip);
 
-    Text winText(message, font, 40);
+    Text& winText = texts.get(*font, message, 40);
     winText.setFillColor(Color::Red);
     FloatRect bounds = winText.getLocalBounds();
     winText.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
     winText.setPosition(window.getSize().x / 2.f, stripY + stripHeight / 2.f - 20);
     window.draw(winText);
 
-    Text restart("Press 'R' to restart", font, 24);
+    Text& restart = texts.get(*font, "Press 'R' to restart", 24);
     restart.setFillColor(Color::Black);
     FloatRect bounds2 = restart.getLocalBounds();
     restart.setOrigin(bounds2.width / 2.f, bounds2.height / 2.f);
@@ -44,129 +84,183 @@ void drawOverlay(RenderWindow& window, const string& message) {
     window.draw(restart);
 }
 
-void playMemoryMatch() {
-    RenderWindow window(VideoMode(500, 500), "Memory Game - 4x4");
-
-    if (!font.loadFromFile("arial.ttf")) {
-        cout << "Failed to load font!\n";
-        return;
+class MemoryMatchScene : public Scene {
+public:
+    explicit MemoryMatchScene(int preset)
+        : preset(preset), game(GRID_PRESETS[preset].rows, GRID_PRESETS[preset].cols),
+          cardSize(GRID_PRESETS[preset].cardSize), spacing(cardSize / 10.f), pitch(cardSize + spacing),
+          contentWidth(2 * offset + game.cols * pitch - spacing), contentHeight(2 * offset + game.rows * pitch - spacing),
+          windowWidth(clampWindow(contentWidth)), windowHeight(clampWindow(contentHeight)),
+          labels(*font, static_cast<unsigned>(cardSize * 0.36f), true), deck(cardDeck()),
+          loadingText(*font, 14, 4, "Loading cards: "), allocWatch("memory match"), winMessage("You Win!") {
+        loadingText.setFillColor(Color(100, 100, 100));
+        loadingText.setPosition(offset, 2);
+        game.reset(static_cast<unsigned>(time(0)));
     }
 
-    vector<int> sequence(totalCards);
-    for (int i = 0; i < totalCards; i += 2) {
-        sequence[i] = sequence[i + 1] = i / 2;
+    void enter(RenderWindow& window) override {
+        title = "Memory Game - " + to_string(game.rows) + "x" + to_string(game.cols) +
+            " (1-" + to_string(GRID_PRESET_COUNT) + " size)";
+        fitWindow(window, windowWidth, windowHeight, title.c_str());
     }
 
-    shuffle(sequence.begin(), sequence.end(), default_random_engine(static_cast<unsigned>(time(0))));
-    vector<bool> revealed(totalCards, false);
-    vector<bool> matched(totalCards, false);
-    vector<int> currentChoice;
-
-    int score = 0;
-    Clock clock;
-    bool isPaused = false;
-    bool gameOver = false;
-    Time pauseStart;
-
-    while (window.isOpen()) {
-        Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == Event::Closed)
-                window.close();
-            else if (event.type == Event::KeyPressed && event.key.code == Keyboard::R && gameOver) {
-                // Reset game
-                shuffle(sequence.begin(), sequence.end(), default_random_engine(static_cast<unsigned>(time(0))));
-                fill(revealed.begin(), revealed.end(), false);
-                fill(matched.begin(), matched.end(), false);
-                currentChoice.clear();
-                score = 0;
-                isPaused = false;
-                gameOver = false;
-            }
-            else if (!gameOver && event.type == Event::MouseButtonPressed && event.mouseButton.button == Mouse::Left) {
-                int x = event.mouseButton.x;
-                int y = event.mouseButton.y;
-
-                for (int i = 0; i < totalCards; ++i) {
-                    float posX = (i % gridSize) * (cardSize + spacing) + offset;
-                    float posY = (i / gridSize) * (cardSize + spacing) + offset;
-
-                    FloatRect bounds(posX, posY, cardSize, cardSize);
-                    if (bounds.contains(static_cast<float>(x), static_cast<float>(y)) && !revealed[i] && !matched[i]) {
-                        if (currentChoice.size() < 2) {
-                            revealed[i] = true;
-                            currentChoice.push_back(i);
-                        }
-                    }
+    void handleEvent(const Event& event) override {
+        if (event.type == Event::KeyPressed && event.key.code == Keyboard::R && game.gameOver) {
+            // Reset game
+            game.reset(static_cast<unsigned>(time(0)));
+        }
+        else if (!game.gameOver && event.type == Event::MouseButtonPressed && event.mouseButton.button == Mouse::Left) {
+            if (game.apply(cardAt(event.mouseButton.x, event.mouseButton.y)))
+                redraw();
+        }
+        else if (event.type == Event::MouseWheelScrolled) {
+            float step = -event.mouseWheelScroll.delta * WHEEL_STEP;
+            if (event.mouseWheelScroll.wheel == Mouse::HorizontalWheel) scrollBy(step, 0);
+            else scrollBy(0, step);
+        }
+        else if (event.type == Event::KeyPressed) {
+            switch (event.key.code) {
+            case Keyboard::Left: scrollBy(-pitch, 0); break;
+            case Keyboard::Right: scrollBy(pitch, 0); break;
+            case Keyboard::Up: scrollBy(0, -pitch); break;
+            case Keyboard::Down: scrollBy(0, pitch); break;
+            default:
+                // Number keys switch grid size; a new scene resizes the window to fit
+                if (event.key.code >= Keyboard::Num1 && event.key.code < Keyboard::Num1 + GRID_PRESET_COUNT) {
+                    int chosen = event.key.code - Keyboard::Num1;
+                    if (chosen != preset)
+                        scenes().replace(makeMemoryMatchScene(chosen));
                 }
+                break;
             }
         }
+    }
 
-        if (!isPaused && currentChoice.size() == 2) {
-            isPaused = true;
-            pauseStart = clock.getElapsedTime();
-        }
+    void update(float dt) override {
+        allocWatch.frameStart();
+        bool wasPaused = game.isPaused;
+        game.step(dt);
+        if (game.isPaused != wasPaused)
+            redraw();   // the pair was matched or flipped back
+        if (deck.poll())
+            redraw();   // more faces replace their placeholders
+    }
 
-        if (isPaused && clock.getElapsedTime() - pauseStart > seconds(1)) {
-            if (sequence[currentChoice[0]] == sequence[currentChoice[1]]) {
-                matched[currentChoice[0]] = matched[currentChoice[1]] = true;
-                score++;
-            }
-            else {
-                revealed[currentChoice[0]] = revealed[currentChoice[1]] = false;
+    // Asleep until a click, or until a face-up pair is due to resolve; polled while
+    // the deck is still loading
+    sf::Time wakeAfter() const override {
+        float t = game.timeUntilStep();
+        sf::Time step = t < 0 ? WAIT_FOR_INPUT : sf::seconds(t) + sf::milliseconds(1);
+        if (deck.loading() && (step == WAIT_FOR_INPUT || step > DECK_POLL_INTERVAL))
+            return DECK_POLL_INTERVAL;
+        return step;
+    }
+
+    void render(RenderWindow& window) override {
+        window.clear(Color(240, 240, 240)); // Light background
+
+        // Draw the cards inside the window only, in grid coordinates shifted by the scroll
+        cards.clear();
+        faces.clear();
+        labels.clear();
+        const Color deepGreen(22, 101, 52);
+        int firstCol = max(0, static_cast<int>((scrollX - offset) / pitch));
+        int firstRow = max(0, static_cast<int>((scrollY - offset) / pitch));
+        int lastCol = min(game.cols - 1, static_cast<int>((scrollX + windowWidth - offset) / pitch));
+        int lastRow = min(game.rows - 1, static_cast<int>((scrollY + windowHeight - offset) / pitch));
+        for (int r = firstRow; r <= lastRow; ++r) {
+            for (int c = firstCol; c <= lastCol; ++c) {
+                int i = r * game.cols + c;
+                if (i >= game.totalCards) break;
+                float posX = c * pitch + offset;
+                float posY = r * pitch + offset;
+                bool faceUp = game.isFaceUp(i);
+
+                cards.addOutlinedRect(posX, posY, cardSize, cardSize,
+                    faceUp ? Color(215, 245, 227) : Color(74, 222, 128), Color::Black, 2);
+                // Image when the deck has one for this face, its number until then
+                if (faceUp && deck.ready(game.face(i))) {
+                    float inset = cardSize / 16.f;
+                    faces.addTexturedRect(posX + inset, posY + inset, cardSize - 2 * inset, cardSize - 2 * inset,
+                        deck.texRect(game.face(i)));
+                    continue;
+                }
+                char digits[12];
+                int n = faceUp ? snprintf(digits, sizeof(digits), "%d", game.face(i)) : 0;
+                labels.addCentered(faceUp ? string_view(digits, n) : string_view("*"),
+                    posX + cardSize / 2.f, posY + cardSize / 2.f, deepGreen);
             }
-            currentChoice.clear();
-            isPaused = false;
         }
+        RenderStates scrolled;
+        scrolled.transform.translate(-scrollX, -scrollY);
+        window.draw(cards, scrolled);
+        RenderStates atlas = scrolled;
+        atlas.texture = &deck.texture();
+        window.draw(faces, atlas);
+        window.draw(labels, scrolled);
 
-        if (!gameOver && all_of(matched.begin(), matched.end(), [](bool m) { return m; })) {
-            gameOver = true;
+        if (deck.loading()) {
+            loadingText.setValue(deck.loadedCount());
+            window.draw(loadingText);
         }
 
-        window.clear(Color(240, 240, 240)); // Light background
-
-        // Draw cards
-        for (int i = 0; i < totalCards; ++i) {
-            float posX = (i % gridSize) * (cardSize + spacing) + offset;
-            float posY = (i / gridSize) * (cardSize + spacing) + offset;
-
-            RectangleShape card(Vector2f(cardSize, cardSize));
-            card.setPosition(posX, posY);
-            card.setOutlineThickness(2);
-            card.setOutlineColor(Color::Black);
+        if (game.gameOver) {
+            drawOverlay(window, winMessage);
+        }
+        allocWatch.frameEnd();
+    }
 
-            if (revealed[i] || matched[i]) {
-                card.setFillColor(Color(215, 245, 227));  // revealed
-                window.draw(card);
+private:
+    static unsigned clampWindow(float content) {
+        return min(MAX_WINDOW, max(MIN_WINDOW, static_cast<unsigned>(ceil(content))));
+    }
 
-                Text number(to_string(sequence[i]), font, 36);
-                number.setFillColor(Color(22, 101, 52)); // Deep green
-                number.setStyle(Text::Bold);
+    // Card under a window pixel by arithmetic on the grid pitch; -1 for a gap,
+    // the margin or the empty cell of an odd-sized grid
+    int cardAt(int x, int y) const {
+        float gridX = x + scrollX - offset, gridY = y + scrollY - offset;
+        if (gridX < 0 || gridY < 0) return -1;
+        int c = static_cast<int>(gridX / pitch), r = static_cast<int>(gridY / pitch);
+        if (c >= game.cols || r >= game.rows) return -1;
+        if (gridX - c * pitch >= cardSize || gridY - r * pitch >= cardSize) return -1;
+        int card = r * game.cols + c;
+        return card < game.totalCards ? card : -1;
+    }
 
-                FloatRect textRect = number.getLocalBounds();
-                number.setOrigin(textRect.left + textRect.width / 2.f, textRect.top + textRect.height / 2.f);
-                number.setPosition(posX + cardSize / 2.f, posY + cardSize / 2.f);
-                window.draw(number);
-            }
-            else {
-                card.setFillColor(Color(74, 222, 128)); // light green back
-                window.draw(card);
-
-                Text star("*", font, 36);
-                star.setFillColor(Color(22, 101, 52)); // deep green
-                star.setStyle(Text::Bold);
-
-                FloatRect textRect = star.getLocalBounds();
-                star.setOrigin(textRect.left + textRect.width / 2.f, textRect.top + textRect.height / 2.f);
-                star.setPosition(posX + cardSize / 2.f, posY + cardSize / 2.f);
-                window.draw(star);
-            }
+    void scrollBy(float dx, float dy) {
+        float x = max(0.f, min(scrollX + dx, contentWidth - windowWidth));
+        float y = max(0.f, min(scrollY + dy, contentHeight - windowHeight));
+        if (x != scrollX || y != scrollY) {
+            scrollX = x;
+            scrollY = y;
+            redraw();
         }
+    }
 
-        if (gameOver) {
-            drawOverlay(window, "You Win!");
-        }
+    const int preset;
+    MemoryMatchGame game;
+    const float cardSize, spacing, pitch;
+    const float contentWidth, contentHeight;
+    const unsigned windowWidth, windowHeight;
+    float scrollX = 0.f, scrollY = 0.f;
+    string title;
+    // All cards in one draw call, every image face in one more (from the deck's
+    // atlas) and all the number labels in a third
+    TileBatch cards;
+    TileBatch faces;
+    TextBatch labels;
+    CardDeck& deck;
+    NumberText loadingText;
+    debug::FrameAllocations allocWatch;
+    const string winMessage;
+};
 
-        window.display();
+std::unique_ptr<Scene> makeMemoryMatchScene(int preset) {
+    font = Assets::font("arial.ttf");
+    if (!font) {
+        cout << "Failed to load font!\n";
+        return nullptr;
     }
+    if (preset < 0 || preset >= GRID_PRESET_COUNT) return nullptr;
+    return std::make_unique<MemoryMatchScene>(preset);
 }
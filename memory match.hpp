@@ -1,6 +1,9 @@
 #ifndef MEMORYMATCH_HPP
 #define MEMORYMATCH_HPP
 
-void playMemoryMatch();
+#include "scene.hpp"
+
+// preset indexes the grid sizes, 4x4 up to 32x32
+std::unique_ptr<Scene> makeMemoryMatchScene(int preset = 0);
 
 #endif // MEMORYMATCH_HPP
@@ -1,234 +1,625 @@
 #include "Minesweeper.hpp"
-#include <cstdlib>
-#include <ctime>
+#include "tile_batch.hpp"
+#include "text_cache.hpp"
+#include "alloc_counter.hpp"
+#include "assets.hpp"
+#include "board_camera.hpp"
+#include "core/minesweeper_generator.hpp"
+#include "core/minesweeper_solver.hpp"
+#include "core/minesweeper_world.hpp"
+#include <algorithm>
+#include <random>
 
 namespace Minesweeper {
 
-    std::vector<std::vector<Tile>> grid(GRID_SIZE, std::vector<Tile>(GRID_SIZE));
-    bool gameOver = false;
-    bool won = false;
-    time_t startTime;
-    int bestTime = INT_MAX;
-    bool timerRunning = false;
-    int finalTime = 0;
-    sf::Font font;
-
-    void loadHighScore() {
+    // One time per line in preset order; older files hold only the beginner time
+    std::vector<int> loadBestTimes() {
+        std::vector<int> times(DIFFICULTY_COUNT, INT_MAX);
         std::ifstream file("minesweeper_besttime.txt");
         if (file.is_open()) {
-            file >> bestTime;
-            if (file.fail()) bestTime = INT_MAX;
+            for (int& time : times)
+                if (!(file >> time)) {
+                    time = INT_MAX;
+                    break;
+                }
             file.close();
         }
+        return times;
     }
 
-    void saveHighScore(int time) {
+    void saveBestTimes(const std::vector<int>& times) {
         std::ofstream file("minesweeper_besttime.txt");
         if (file.is_open()) {
-            file << time;
+            for (int time : times)
+                file << time << "\n";
             file.close();
         }
     }
 
-    void placeMines() {
-        srand(static_cast<unsigned>(time(nullptr)));
-        int placed = 0;
-        while (placed < NUM_MINES) {
-            int r = rand() % GRID_SIZE;
-            int c = rand() % GRID_SIZE;
-            if (!grid[r][c].mine) {
-                grid[r][c].mine = true;
-                placed++;
-            }
+    // One tile at pixel (x, y): the square, then its flag, mine or number
+    void addTile(TileBatch& batch, TextBatch& labels, const Tile& tile, float x, float y) {
+        batch.addRect(x + 1, y + 1, TILE_SIZE - 2, TILE_SIZE - 2,
+            tile.revealed() ? sf::Color(180, 180, 180) : sf::Color(200, 200, 200));
+        if (tile.flagged() && !tile.revealed())
+            labels.add("F", x + 8, y + 4, sf::Color::Red);
+        else if (tile.revealed() && tile.mine())
+            batch.addCircle(x + 6, y + 6, 10, sf::Color::Black);
+        else if (tile.revealed() && tile.adjacentMines() > 0) {
+            const char digit = static_cast<char>('0' + tile.adjacentMines());
+            labels.add(std::string_view(&digit, 1), x + 10, y + 4, sf::Color::Blue);
         }
     }
 
-    void calculateAdjacency() {
-        for (int r = 0; r < GRID_SIZE; ++r) {
-            for (int c = 0; c < GRID_SIZE; ++c) {
-                if (grid[r][c].mine) continue;
-                int count = 0;
-                for (int dr = -1; dr <= 1; ++dr) {
-                    for (int dc = -1; dc <= 1; ++dc) {
-                        int nr = r + dr, nc = c + dc;
-                        if (nr >= 0 && nr < GRID_SIZE && nc >= 0 && nc < GRID_SIZE && grid[nr][nc].mine)
-                            count++;
-                    }
-                }
-                grid[r][c].adjacentMines = count;
-            }
+    // Colour of a tile in the zoomed-out view, where each tile is at most a few pixels
+    sf::Color lodColor(const Tile& tile) {
+        if (!tile.revealed()) return tile.flagged() ? sf::Color::Red : sf::Color(200, 200, 200);
+        if (tile.mine()) return sf::Color::Black;
+        if (tile.adjacentMines() > 0) {
+            sf::Uint8 shade = static_cast<sf::Uint8>(170 - 12 * tile.adjacentMines());
+            return sf::Color(shade, shade, 220);
         }
+        return sf::Color(180, 180, 180);
     }
 
-    void reveal(int r, int c) {
-        if (r < 0 || r >= GRID_SIZE || c < 0 || c >= GRID_SIZE || grid[r][c].revealed || grid[r][c].flagged)
-            return;
-        grid[r][c].revealed = true;
-        if (grid[r][c].adjacentMines == 0 && !grid[r][c].mine) {
-            for (int dr = -1; dr <= 1; ++dr)
-                for (int dc = -1; dc <= 1; ++dc)
-                    reveal(r + dr, c + dc);
-        }
+    // Boards are built on worker threads ahead of time, for every preset in the mode
+    // being played, so a new round never waits for the solver to vet a layout
+    core::MinesweeperBoardPool& boardPool() {
+        static core::MinesweeperBoardPool pool;
+        return pool;
     }
 
-    bool checkWin() {
-        for (int r = 0; r < GRID_SIZE; ++r)
-            for (int c = 0; c < GRID_SIZE; ++c)
-                if (!grid[r][c].mine && !grid[r][c].revealed)
-                    return false;
-        return true;
-    }
+    // Vetting a board this large would take the solver seconds per candidate
+    const int NO_GUESS_MAX_TILES = 10000;
+    // How often a scene waiting for a board checks the pool
+    const sf::Time BOARD_POLL_INTERVAL = sf::milliseconds(50);
 
-    void playMinesweeper() {
-        sf::RenderWindow window(sf::VideoMode(GRID_SIZE * TILE_SIZE, GRID_SIZE * TILE_SIZE + BOTTOM_UI_HEIGHT), "Minesweeper 9x9");
-        sf::RectangleShape tileShape(sf::Vector2f(TILE_SIZE - 2, TILE_SIZE - 2));
-
-        if (!font.loadFromFile("arial.ttf")) return;
-
-        auto resetGame = [&]() {
-            for (auto& row : grid)
-                for (auto& tile : row)
-                    tile = Tile{};
-
-            placeMines();
-            calculateAdjacency();
-
-            gameOver = false;
-            won = false;
-            startTime = time(nullptr);
-            timerRunning = true;
-            finalTime = 0;      // <-- RESET SAVED TIME
-            };
-
-        loadHighScore();
-        resetGame();
-
-        while (window.isOpen()) {
-            sf::Event event;
-            while (window.pollEvent(event)) {
-                if (event.type == sf::Event::Closed)
-                    window.close();
-
-                if (!gameOver && event.type == sf::Event::MouseButtonPressed) {
-                    int x = event.mouseButton.x / TILE_SIZE;
-                    int y = event.mouseButton.y / TILE_SIZE;
-                    if (x < GRID_SIZE && y < GRID_SIZE) {
-
-                        // LEFT CLICK
-                        if (event.mouseButton.button == sf::Mouse::Left && !grid[y][x].flagged) {
-                            if (grid[y][x].mine) {
-
-                                // ---- LOSS ----
-                                gameOver = true;
-                                timerRunning = false;
-                                finalTime = static_cast<int>(time(nullptr) - startTime);   // <-- FREEZE TIME
-                                grid[y][x].revealed = true;
-
-                                for (auto& row : grid)
-                                    for (auto& tile : row)
-                                        if (tile.mine)
-                                            tile.revealed = true;
-                            }
-                            else {
-                                reveal(y, x);
+    core::MinesweeperBoardSpec boardSpec(int difficulty, bool noGuess) {
+        const Difficulty& d = DIFFICULTIES[difficulty];
+        return { d.rows, d.cols, d.mines, noGuess && d.rows * d.cols <= NO_GUESS_MAX_TILES };
+    }
 
-                                if (checkWin()) {
+    class MinesweeperScene : public Scene {
+    public:
+        MinesweeperScene(const sf::Font& font, int difficulty, bool noGuess)
+            : font(font), difficulty(difficulty), preset(DIFFICULTIES[difficulty]), noGuess(noGuess),
+              boardWidth(std::min(preset.cols * TILE_SIZE, MAX_VIEW_WIDTH)),
+              boardHeight(std::min(preset.rows * TILE_SIZE, MAX_VIEW_HEIGHT)),
+              camera(TILE_SIZE), labels(font, 20),
+              bestTimeText(font, 20, 6, "Best Time: ", "s"), elapsedTimeText(font, 20, 6, "Time: ", "s"),
+              guessText(font, 16, 3, "Hint: guess, ", "% mine"),
+              overlay(sf::Vector2f(static_cast<float>(boardWidth), 60)), allocWatch("minesweeper"),
+              game(preset.rows, preset.cols, preset.mines), bestTimes(loadBestTimes()) {
+            bestTimeText.setFillColor(sf::Color::Black);
+            bestTimeText.setPosition(5, boardHeight + 5);
+            elapsedTimeText.setFillColor(sf::Color::Black);
+            elapsedTimeText.setPosition(5, boardHeight + 30);
+            guessText.setFillColor(sf::Color(160, 120, 0));
+            guessText.setPosition(5, boardHeight + 56);
+            hintBox.setSize(sf::Vector2f(TILE_SIZE - 4.f, TILE_SIZE - 4.f));
+            hintBox.setFillColor(sf::Color::Transparent);
+            hintBox.setOutlineThickness(3);
+            overlay.setFillColor(sf::Color(255, 255, 255, 220));
+            overlay.setPosition(0, boardHeight / 2.f - 30);
+
+            // Zoom out until the whole board fits, and in to twice the tile size
+            camera.setArea(static_cast<float>(boardWidth), static_cast<float>(boardHeight),
+                static_cast<float>(boardWidth), static_cast<float>(boardHeight + BOTTOM_UI_HEIGHT));
+            camera.setLimits(preset.rows, preset.cols);
+            float fit = std::min(static_cast<float>(boardWidth) / preset.cols, static_cast<float>(boardHeight) / preset.rows);
+            camera.setZoomRange(std::min(fit, static_cast<float>(TILE_SIZE)), 2.f * TILE_SIZE);
+
+            resetGame();
+        }
 
-                                    // ---- WIN ----
-                                    gameOver = true;
-                                    won = true;
-                                    timerRunning = false;
-                                    finalTime = static_cast<int>(time(nullptr) - startTime);  // <-- FREEZE TIME
+        void enter(sf::RenderWindow& window) override {
+            title = std::string("Minesweeper ") + preset.name + " (1-" + std::to_string(DIFFICULTY_COUNT) + ", E endless)";
+            fitWindow(window, boardWidth, boardHeight + BOTTOM_UI_HEIGHT, title.c_str());
+        }
 
-                                    if (finalTime < bestTime) {
-                                        bestTime = finalTime;
-                                        saveHighScore(finalTime);
-                                    }
-                                }
-                            }
-                        }
-                        // RIGHT CLICK
-                        else if (event.mouseButton.button == sf::Mouse::Right) {
-                            grid[y][x].flagged = !grid[y][x].flagged;
-                        }
-                    }
+        void handleEvent(const sf::Event& event) override {
+            if (camera.handleEvent(event)) {
+                tiles.invalidate();
+                redraw();
+            }
+            else if (!game.gameOver && !waitingForBoard && event.type == sf::Event::MouseButtonPressed) {
+                int x, y;
+                if (!camera.tileAt(event.mouseButton.x, event.mouseButton.y, y, x)) return;
+                tiles.invalidate();
+                hint.reason = core::MinesweeperSolver::NONE;
+
+                // LEFT CLICK
+                if (event.mouseButton.button == sf::Mouse::Left) {
+                    reveal(y, x);
                 }
-                else if (gameOver && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Enter) {
-                    resetGame();
+                // RIGHT CLICK
+                else if (event.mouseButton.button == sf::Mouse::Right) {
+                    game.apply(core::MinesweeperGame::FLAG, y, x);
                 }
             }
+            else if (game.gameOver && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Enter) {
+                resetGame();
+            }
+            // H shows the solver's next move; A lets it play until the round ends.
+            // Either one means this round's time is not recorded.
+            else if (!game.gameOver && !waitingForBoard && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H) {
+                hint = nextMove();
+                assisted = true;
+                if (hint.reason != core::MinesweeperSolver::NONE)
+                    showTile(hint.row, hint.col);
+                redraw();
+            }
+            else if (!game.gameOver && !waitingForBoard && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::A) {
+                autoPlay = !autoPlay;
+                autoWait = 0.f;
+                assisted = true;
+                redraw();
+            }
+            // Number keys switch board size; a new scene resizes the window to fit
+            else if (event.type == sf::Event::KeyPressed && event.key.code >= sf::Keyboard::Num1 &&
+                event.key.code < sf::Keyboard::Num1 + DIFFICULTY_COUNT) {
+                int chosen = event.key.code - sf::Keyboard::Num1;
+                if (chosen != difficulty)
+                    scenes().replace(makeMinesweeperScene(chosen, noGuess));
+            }
+            else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::E) {
+                scenes().replace(makeEndlessMinesweeperScene());
+            }
+            // N switches between no-guess boards and plain ones; both start first-click safe
+            else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::N) {
+                noGuess = !noGuess;
+                resetGame();
+                redraw();
+            }
+        }
 
-            window.clear(sf::Color::White);
+        void update(float dt) override {
+            allocWatch.frameStart();
+            if (waitingForBoard) {
+                if (takeBoard())
+                    redraw();
+                return;
+            }
+            int shown = game.elapsedSeconds();
+            game.step(dt);
+            if (game.elapsedSeconds() != shown)
+                redraw();
+
+            if (autoPlay && !game.gameOver) {
+                autoWait -= dt;
+                if (autoWait <= 0.f) {
+                    autoWait = AUTO_PLAY_DELAY;
+                    playSolverMove();
+                }
+            }
+        }
 
-            // DRAW GRID
-            for (int r = 0; r < GRID_SIZE; ++r) {
-                for (int c = 0; c < GRID_SIZE; ++c) {
-                    tileShape.setPosition(c * TILE_SIZE + 1, r * TILE_SIZE + 1);
-                    tileShape.setFillColor(grid[r][c].revealed ? sf::Color(180, 180, 180) : sf::Color(200, 200, 200));
-                    window.draw(tileShape);
-
-                    if (grid[r][c].flagged && !grid[r][c].revealed) {
-                        sf::Text flag("F", font, 20);
-                        flag.setFillColor(sf::Color::Red);
-                        flag.setPosition(c * TILE_SIZE + 8, r * TILE_SIZE + 4);
-                        window.draw(flag);
-                    }
-                    else if (grid[r][c].revealed && grid[r][c].mine) {
-                        sf::CircleShape mineShape(10);
-                        mineShape.setFillColor(sf::Color::Black);
-                        mineShape.setPosition(c * TILE_SIZE + 6, r * TILE_SIZE + 6);
-                        window.draw(mineShape);
-                    }
-                    else if (grid[r][c].revealed && grid[r][c].adjacentMines > 0) {
-                        sf::Text number(std::to_string(grid[r][c].adjacentMines), font, 20);
-                        number.setFillColor(sf::Color::Blue);
-                        number.setPosition(c * TILE_SIZE + 10, r * TILE_SIZE + 4);
-                        window.draw(number);
+        // Without input only the clock changes, so wake once per displayed second,
+        // or once per move while the solver is playing, or to poll for a board
+        sf::Time wakeAfter() const override {
+            if (waitingForBoard)
+                return BOARD_POLL_INTERVAL;
+            if (autoPlay && !game.gameOver)
+                return sf::seconds(std::max(autoWait, 0.f));
+            float t = game.timeUntilNextSecond();
+            return t < 0 ? WAIT_FOR_INPUT : sf::seconds(t) + sf::milliseconds(1);
+        }
+
+        void render(sf::RenderWindow& window) override {
+            window.clear(sf::Color::White);
+            const sf::View ui = window.getView();
+            window.setView(camera.view());
+
+            // DRAW GRID: only the tiles on screen, or one pixel per screen pixel when
+            // tiles are too small for numbers, so the cost does not grow with the board
+            bool zoomedOut = camera.pixelsPerTile() < LOD_TILE_PIXELS;
+            if (tiles.dirty()) {
+                TileBatch& batch = tiles.edit();
+                labels.clear();
+                if (zoomedOut) {
+                    pixelMap.build(camera, TILE_SIZE, [this](int r, int c) {
+                        if (!game.inside(r, c)) return sf::Color::White;
+                        if (!game.started() && r == startRow && c == startCol) return sf::Color(0, 170, 0);
+                        return lodColor(game.at(r, c));
+                    });
+                }
+                else {
+                    int firstRow, firstCol, lastRow, lastCol;
+                    camera.visibleTiles(firstRow, firstCol, lastRow, lastCol);
+                    for (int r = firstRow; r <= lastRow; ++r) {
+                        for (int c = firstCol; c <= lastCol; ++c) {
+                            if (!game.started() && r == startRow && c == startCol) {
+                                batch.addRect(c * TILE_SIZE + 1, r * TILE_SIZE + 1, TILE_SIZE - 2, TILE_SIZE - 2, sf::Color(200, 200, 200));
+                                batch.addCircle(c * TILE_SIZE + 10, r * TILE_SIZE + 10, 6, sf::Color(0, 170, 0));
+                            }
+                            else {
+                                addTile(batch, labels, game.at(r, c), c * TILE_SIZE, r * TILE_SIZE);
+                            }
+                        }
                     }
                 }
+                tiles.upload();
+            }
+            if (zoomedOut) {
+                window.draw(pixelMap);
+            }
+            else {
+                window.draw(tiles);
+                window.draw(labels);
             }
 
-            // ---- FIXED TIMER DISPLAY ----
-            int elapsedTime;
+            // HINT: green is safe, red a certain mine, yellow the best guess
+            if (hint.reason != core::MinesweeperSolver::NONE && !game.gameOver) {
+                const sf::Color colors[] = { sf::Color(0, 170, 0), sf::Color::Red, sf::Color(230, 180, 0) };
+                hintBox.setOutlineColor(colors[hint.reason]);
+                hintBox.setPosition(hint.col * TILE_SIZE + 2.f, hint.row * TILE_SIZE + 2.f);
+                window.draw(hintBox);
+            }
+            window.setView(ui);
 
-            if (timerRunning)
-                elapsedTime = static_cast<int>(time(nullptr) - startTime);
-            else
-                elapsedTime = finalTime;   // <-- SHOW FROZEN TIME
+            // ---- FIXED TIMER DISPLAY ----
+            int elapsedTime = game.elapsedSeconds();   // frozen by the core once the round ends
 
             // BEST TIME UI
-            std::string bestTimeStr = (bestTime == INT_MAX) ? "N/A" : std::to_string(bestTime);
-            sf::Text bestTimeText("Best Time: " + bestTimeStr + "s", font, 20);
-            bestTimeText.setFillColor(sf::Color::Black);
-            bestTimeText.setPosition(5, GRID_SIZE * TILE_SIZE + 5);
+            if (bestTimes[difficulty] == INT_MAX) bestTimeText.setText("N/A");
+            else bestTimeText.setValue(bestTimes[difficulty]);
             window.draw(bestTimeText);
 
             // CURRENT TIME UI
-            sf::Text elapsedTimeText("Time: " + std::to_string(elapsedTime) + "s", font, 20);
-            elapsedTimeText.setFillColor(sf::Color::Black);
-            elapsedTimeText.setPosition(5, GRID_SIZE * TILE_SIZE + 30);
+            elapsedTimeText.setValue(elapsedTime);
             window.draw(elapsedTimeText);
 
+            // HINT / AUTO-PLAY LINE
+            if (waitingForBoard) {
+                drawStatus(window, "Generating board...", sf::Color(100, 100, 100));
+            }
+            else if (autoPlay && !game.gameOver) {
+                drawStatus(window, "Auto-playing (A to stop)", sf::Color::Black);
+            }
+            else if (hint.reason == core::MinesweeperSolver::GUESS && !game.gameOver) {
+                guessText.setValue(static_cast<long long>(hint.mineChance * 100.f + 0.5f));
+                window.draw(guessText);
+            }
+            else if (hint.reason == core::MinesweeperSolver::SAFE && !game.gameOver) {
+                drawStatus(window, "Hint: safe", sf::Color(0, 140, 0));
+            }
+            else if (hint.reason == core::MinesweeperSolver::MINE && !game.gameOver) {
+                drawStatus(window, "Hint: mine", sf::Color::Red);
+            }
+            else if (!game.gameOver) {
+                drawStatus(window, noGuess ? "H: hint  A: auto  N: no-guess on" : "H: hint  A: auto  N: no-guess off",
+                    sf::Color(100, 100, 100));
+            }
+
             // GAME OVER OVERLAY
-            if (gameOver) {
-                sf::RectangleShape overlay(sf::Vector2f(GRID_SIZE * TILE_SIZE, 60));
-                overlay.setFillColor(sf::Color(255, 255, 255, 220));
-                overlay.setPosition(0, GRID_SIZE * TILE_SIZE / 2.f - 30);
+            if (game.gameOver) {
                 window.draw(overlay);
 
-                sf::Text msg(won ? "You Win!" : "Game Over", font, 25);
-                msg.setFillColor(won ? sf::Color::Green : sf::Color::Red);
+                sf::Text& msg = texts.get(font, game.won ? "You Win!" : "Game Over", 25);
+                msg.setFillColor(game.won ? sf::Color::Green : sf::Color::Red);
+                msg.setStyle(sf::Text::Bold);
+                msg.setPosition(boardWidth / 2.f - msg.getLocalBounds().width / 2.f, boardHeight / 2.f - 20);
+                window.draw(msg);
+
+                sf::Text& restartMsg = texts.get(font, "Press Enter to Restart", 20);
+                restartMsg.setFillColor(sf::Color::Black);
+                restartMsg.setPosition(boardWidth / 2.f - restartMsg.getLocalBounds().width / 2.f, boardHeight / 2.f + 10);
+                window.draw(restartMsg);
+            }
+            allocWatch.frameEnd();
+        }
+
+    private:
+        void resetGame() {
+            hint.reason = core::MinesweeperSolver::NONE;
+            autoPlay = false;
+            assisted = false;
+            if (takeBoard()) return;
+
+            // Nothing in stock yet: show a covered, mine-free board and ignore play
+            // until update() gets one from the workers
+            waitingForBoard = true;
+            startRow = startCol = -1;
+            game.reset(preset.rows, preset.cols, 0, 0);
+            tiles.invalidate();
+        }
+
+        // Loads a finished board from the pool; false while none is ready
+        bool takeBoard() {
+            core::MinesweeperLayout board;
+            if (!boardPool().take(boardSpec(difficulty, noGuess), board)) return false;
+            waitingForBoard = false;
+            startRow = board.startRow;
+            startCol = board.startCol;
+            game.load(board);
+            solver.reset(game);
+            if (startRow >= 0)
+                camera.centerOnTile(static_cast<float>(startRow), static_cast<float>(startCol));
+            tiles.invalidate();
+            return true;
+        }
+
+        void reveal(int r, int c) {
+            if (!game.apply(core::MinesweeperGame::REVEAL, r, c)) return;
+            solver.observe(game, r, c);
+            if (game.won && !assisted) {
+                // ---- WIN ----
+                int finalTime = game.elapsedSeconds();
+                if (finalTime < bestTimes[difficulty]) {
+                    bestTimes[difficulty] = finalTime;
+                    saveBestTimes(bestTimes);
+                }
+            }
+        }
+
+        // Pans to a tile that is off screen
+        void showTile(int r, int c) {
+            int firstRow, firstCol, lastRow, lastCol;
+            camera.visibleTiles(firstRow, firstCol, lastRow, lastCol);
+            if (r < firstRow || r > lastRow || c < firstCol || c > lastCol) {
+                camera.centerOnTile(static_cast<float>(r), static_cast<float>(c));
+                tiles.invalidate();
+            }
+        }
+
+        // Before the first click the marked start tile is the move; the solver alone
+        // would only see a blank board and pick a corner
+        core::MinesweeperSolver::Move nextMove() {
+            core::MinesweeperSolver::Move move;
+            if (!game.started() && startRow >= 0) {
+                move.row = startRow;
+                move.col = startCol;
+                move.reason = core::MinesweeperSolver::SAFE;
+                return move;
+            }
+            return solver.next(game);
+        }
+
+        // One solver move per call: certain mines are flagged, everything else revealed
+        void playSolverMove() {
+            core::MinesweeperSolver::Move move = nextMove();
+            hint.reason = core::MinesweeperSolver::NONE;
+            if (move.reason == core::MinesweeperSolver::NONE) {
+                autoPlay = false;
+            }
+            else if (move.reason == core::MinesweeperSolver::MINE) {
+                if (!game.at(move.row, move.col).flagged())
+                    game.apply(core::MinesweeperGame::FLAG, move.row, move.col);
+            }
+            else {
+                // The solver ignores the player's flags, which may be wrong
+                if (game.at(move.row, move.col).flagged())
+                    game.apply(core::MinesweeperGame::FLAG, move.row, move.col);
+                reveal(move.row, move.col);
+            }
+            if (move.reason != core::MinesweeperSolver::NONE)
+                showTile(move.row, move.col);
+            tiles.invalidate();
+            redraw();
+        }
+
+        void drawStatus(sf::RenderWindow& window, std::string_view str, const sf::Color& color) {
+            sf::Text& text = texts.get(font, str, 16);
+            text.setFillColor(color);
+            text.setPosition(5, boardHeight + 56);
+            window.draw(text);
+        }
+
+        // Seconds between auto-play moves, slow enough to follow on screen
+        static constexpr float AUTO_PLAY_DELAY = 0.03f;
+
+        const sf::Font& font;
+        const int difficulty;
+        const Difficulty& preset;
+        bool noGuess;
+        const int boardWidth, boardHeight;     // the window's board area, at most MAX_VIEW_*
+        std::string title;
+
+        // The board is two draw calls, tiles and labels, rebuilt only after a move or
+        // a camera change; zoomed out it is the pixel map instead
+        BoardCamera camera;
+        StaticTileBatch tiles;
+        TextBatch labels;
+        TilePixelMap pixelMap;
+
+        // Status line and overlay are built once; the times update in place
+        TextCache texts;
+        NumberText bestTimeText;
+        NumberText elapsedTimeText;
+        NumberText guessText;
+        sf::RectangleShape overlay;
+        sf::RectangleShape hintBox;
+        debug::FrameAllocations allocWatch;
+
+        core::MinesweeperGame game;
+        std::vector<int> bestTimes;
+        int startRow = -1, startCol = -1;     // marked until the first click
+
+        core::MinesweeperSolver solver;
+        core::MinesweeperSolver::Move hint;   // shown until the next move
+        bool autoPlay = false;
+        float autoWait = 0.f;
+        bool assisted = false;                // hints or auto-play used this round
+        bool waitingForBoard = false;         // the pool had none ready; the board shown is blank
+    };
+
+    // Endless mode: a camera onto an unbounded world. The world builds chunks as the
+    // view or a reveal reaches them and drops untouched ones once the view has moved
+    // well away.
+    class EndlessMinesweeperScene : public Scene {
+    public:
+        static constexpr int VIEW_COLS = MAX_VIEW_WIDTH / TILE_SIZE;
+        static constexpr int VIEW_ROWS = MAX_VIEW_HEIGHT / TILE_SIZE;
+        // Untouched chunks stay cached this many chunks beyond the visible ones
+        static constexpr int KEEP_CHUNKS = 2;
+
+        explicit EndlessMinesweeperScene(const sf::Font& font)
+            : font(font), labels(font, 20),
+              scoreText(font, 20, 9, "Revealed: "), elapsedTimeText(font, 20, 6, "Time: ", "s"),
+              chunkText(font, 16, 6, "Chunks cached: "), memoryText(font, 16, 7, "Memory: ", " KB"),
+              overlay(sf::Vector2f(static_cast<float>(VIEW_COLS * TILE_SIZE), 60)), camera(TILE_SIZE) {
+            scoreText.setFillColor(sf::Color::Black);
+            scoreText.setPosition(5, VIEW_ROWS * TILE_SIZE + 5);
+            elapsedTimeText.setFillColor(sf::Color::Black);
+            elapsedTimeText.setPosition(5, VIEW_ROWS * TILE_SIZE + 30);
+            chunkText.setFillColor(sf::Color(100, 100, 100));
+            chunkText.setPosition(VIEW_COLS * TILE_SIZE - 260.f, VIEW_ROWS * TILE_SIZE + 8);
+            memoryText.setFillColor(sf::Color(100, 100, 100));
+            memoryText.setPosition(VIEW_COLS * TILE_SIZE - 260.f, VIEW_ROWS * TILE_SIZE + 32);
+            overlay.setFillColor(sf::Color(255, 255, 255, 220));
+            overlay.setPosition(0, VIEW_ROWS * TILE_SIZE / 2.f - 30);
+            // Zoomed all the way out a pixel is one tile, which keeps the chunks built
+            // for the view to a few hundred
+            camera.setArea(VIEW_COLS * TILE_SIZE, VIEW_ROWS * TILE_SIZE,
+                VIEW_COLS * TILE_SIZE, VIEW_ROWS * TILE_SIZE + BOTTOM_UI_HEIGHT);
+            camera.setZoomRange(1.f, 2.f * TILE_SIZE);
+            resetGame();
+        }
+
+        void enter(sf::RenderWindow& window) override {
+            fitWindow(window, VIEW_COLS * TILE_SIZE, VIEW_ROWS * TILE_SIZE + BOTTOM_UI_HEIGHT,
+                "Minesweeper Endless (arrows/middle drag pan, wheel zoom, 1-4 presets)");
+        }
+
+        void handleEvent(const sf::Event& event) override {
+            if (camera.handleEvent(event)) {
+                cameraMoved();
+            }
+            else if (!world.gameOver && event.type == sf::Event::MouseButtonPressed) {
+                int r, c;
+                if (!camera.tileAt(event.mouseButton.x, event.mouseButton.y, r, c)) return;
+                if (event.mouseButton.button == sf::Mouse::Left)
+                    world.apply(core::MinesweeperGame::REVEAL, r, c);
+                else if (event.mouseButton.button == sf::Mouse::Right)
+                    world.apply(core::MinesweeperGame::FLAG, r, c);
+                tiles.invalidate();
+                redraw();
+            }
+            else if (world.gameOver && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Enter) {
+                resetGame();
+            }
+            else if (event.type == sf::Event::KeyPressed && event.key.code >= sf::Keyboard::Num1 &&
+                event.key.code < sf::Keyboard::Num1 + DIFFICULTY_COUNT) {
+                scenes().replace(makeMinesweeperScene(event.key.code - sf::Keyboard::Num1));
+            }
+        }
+
+        void update(float dt) override {
+            int shown = static_cast<int>(world.elapsed);
+            world.step(dt);
+            if (static_cast<int>(world.elapsed) != shown)
+                redraw();
+        }
+
+        sf::Time wakeAfter() const override {
+            if (!world.timerRunning) return WAIT_FOR_INPUT;
+            return sf::seconds(static_cast<int>(world.elapsed) + 1 - world.elapsed) + sf::milliseconds(1);
+        }
+
+        void render(sf::RenderWindow& window) override {
+            window.clear(sf::Color::White);
+
+            const sf::View ui = window.getView();
+            window.setView(camera.view());
+            bool zoomedOut = camera.pixelsPerTile() < LOD_TILE_PIXELS;
+            if (tiles.dirty()) {
+                TileBatch& batch = tiles.edit();
+                labels.clear();
+                if (zoomedOut) {
+                    pixelMap.build(camera, TILE_SIZE, [this](int r, int c) { return lodColor(world.at(r, c)); });
+                }
+                else {
+                    int firstRow, firstCol, lastRow, lastCol;
+                    camera.visibleTiles(firstRow, firstCol, lastRow, lastCol);
+                    for (int r = firstRow; r <= lastRow; ++r)
+                        for (int c = firstCol; c <= lastCol; ++c)
+                            addTile(batch, labels, world.at(r, c),
+                                static_cast<float>(c * TILE_SIZE), static_cast<float>(r * TILE_SIZE));
+                }
+                tiles.upload();
+            }
+            if (zoomedOut) {
+                window.draw(pixelMap);
+            }
+            else {
+                window.draw(tiles);
+                window.draw(labels);
+            }
+            window.setView(ui);
+
+            scoreText.setValue(world.revealedCount);
+            window.draw(scoreText);
+            elapsedTimeText.setValue(static_cast<int>(world.elapsed));
+            window.draw(elapsedTimeText);
+            chunkText.setValue(static_cast<long long>(world.chunkCount()));
+            window.draw(chunkText);
+            memoryText.setValue(static_cast<long long>(world.memoryBytes() / 1024));
+            window.draw(memoryText);
+
+            if (world.gameOver) {
+                window.draw(overlay);
+                sf::Text& msg = texts.get(font, "Game Over", 25);
+                msg.setFillColor(sf::Color::Red);
                 msg.setStyle(sf::Text::Bold);
-                msg.setPosition(GRID_SIZE * TILE_SIZE / 2.f - msg.getLocalBounds().width / 2.f, GRID_SIZE * TILE_SIZE / 2.f - 20);
+                msg.setPosition(VIEW_COLS * TILE_SIZE / 2.f - msg.getLocalBounds().width / 2.f, VIEW_ROWS * TILE_SIZE / 2.f - 20);
                 window.draw(msg);
 
-                sf::Text restartMsg("Press Enter to Restart", font, 20);
+                sf::Text& restartMsg = texts.get(font, "Press Enter to Restart", 20);
                 restartMsg.setFillColor(sf::Color::Black);
-                restartMsg.setPosition(GRID_SIZE * TILE_SIZE / 2.f - restartMsg.getLocalBounds().width / 2.f, GRID_SIZE * TILE_SIZE / 2.f + 10);
+                restartMsg.setPosition(VIEW_COLS * TILE_SIZE / 2.f - restartMsg.getLocalBounds().width / 2.f,
+                    VIEW_ROWS * TILE_SIZE / 2.f + 10);
                 window.draw(restartMsg);
             }
+        }
+
+    private:
+        // A new world each round; the safe start at (0, 0) sits in the middle of the view
+        void resetGame() {
+            std::random_device device;
+            world.reset((static_cast<uint64_t>(device()) << 32) | device());
+            camera.centerOnTile(0.f, 0.f);
+            tiles.invalidate();
+            redraw();
+        }
+
+        void cameraMoved() {
+            int firstRow, firstCol, lastRow, lastCol;
+            camera.visibleTiles(firstRow, firstCol, lastRow, lastCol);
+            int span = std::max(lastRow - firstRow, lastCol - firstCol) + 1;
+            int radius = span / core::MinesweeperWorld::CHUNK_SIZE / 2 + 1 + KEEP_CHUNKS;
+            world.evictFar((firstRow + lastRow) / 2, (firstCol + lastCol) / 2, radius);
+            tiles.invalidate();
+            redraw();
+        }
+
+        const sf::Font& font;
+        StaticTileBatch tiles;
+        TextBatch labels;
+        TextCache texts;
+        NumberText scoreText;
+        NumberText elapsedTimeText;
+        NumberText chunkText;
+        NumberText memoryText;
+        sf::RectangleShape overlay;
+        BoardCamera camera;
+        TilePixelMap pixelMap;
+
+        core::MinesweeperWorld world;
+    };
+
+    std::unique_ptr<Scene> makeEndlessMinesweeperScene() {
+        const sf::Font* font = Assets::font("arial.ttf");
+        if (!font) return nullptr;
+        return std::make_unique<EndlessMinesweeperScene>(*font);
+    }
 
-            window.display();
+    std::unique_ptr<Scene> makeMinesweeperScene(int difficulty, bool noGuess) {
+        const sf::Font* font = Assets::font("arial.ttf");
+        if (!font || difficulty < 0 || difficulty >= DIFFICULTY_COUNT) return nullptr;
+        // Both modes, so N switches to a board that is already built
+        for (int d = 0; d < DIFFICULTY_COUNT; ++d) {
+            boardPool().prepare(boardSpec(d, true));
+            boardPool().prepare(boardSpec(d, false));
         }
+        return std::make_unique<MinesweeperScene>(*font, difficulty, noGuess);
     }
 }
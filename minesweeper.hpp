@@ -2,6 +2,8 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
+#include "core/minesweeper_core.hpp"
+#include "scene.hpp"
 #include <vector>
 #include <ctime>
 #include <fstream>
@@ -10,33 +12,37 @@
 
 namespace Minesweeper {
 
-    constexpr int GRID_SIZE = 9;
     constexpr int TILE_SIZE = 32;
-    constexpr int NUM_MINES = 10;
     constexpr int BOTTOM_UI_HEIGHT = 80;
-
-    struct Tile {
-        bool revealed = false;
-        bool flagged = false;
-        bool mine = false;
-        int adjacentMines = 0;
+    // Boards bigger than this are shown through a pan/zoom camera
+    constexpr int MAX_VIEW_WIDTH = 960;
+    constexpr int MAX_VIEW_HEIGHT = 640;
+    // Below this many screen pixels per tile the board is drawn as plain pixels
+    constexpr float LOD_TILE_PIXELS = 12.f;
+
+    using Tile = core::MinesweeperTile;
+
+    // Board presets, picked with the number keys in game
+    struct Difficulty {
+        const char* name;
+        int rows;
+        int cols;
+        int mines;
     };
+    constexpr Difficulty DIFFICULTIES[] = {
+        { "Beginner", 9, 9, 10 },
+        { "Intermediate", 16, 16, 40 },
+        { "Expert", 16, 30, 99 },
+        { "Huge", 1000, 1000, 160000 },
+    };
+    constexpr int DIFFICULTY_COUNT = sizeof(DIFFICULTIES) / sizeof(DIFFICULTIES[0]);
 
-    extern std::vector<std::vector<Tile>> grid;
-    extern bool gameOver;
-    extern bool won;
-    extern time_t startTime;
-    extern int bestTime;
-    extern bool timerRunning;
-    extern sf::Font font;
-
-    void loadHighScore();
-    void saveHighScore(int time);
-    void placeMines();
-    void calculateAdjacency();
-    void reveal(int r, int c);
-    bool checkWin();
-    void playMinesweeper();
+    // Best time per difficulty, INT_MAX where none has been set
+    std::vector<int> loadBestTimes();
+    void saveBestTimes(const std::vector<int>& times);
+    // noGuess rounds use boards the solver has cleared without guessing from the marked start tile
+    std::unique_ptr<Scene> makeMinesweeperScene(int difficulty = 0, bool noGuess = true);
+    // An unbounded board built in chunks as it is explored; the score is tiles revealed
+    std::unique_ptr<Scene> makeEndlessMinesweeperScene();
 
 }
-
@@ -0,0 +1,79 @@
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+class SceneStack;
+
+// One screen of the collection: the menu, a game or a score list. Every scene
+// shares the single window and event loop in main(); a scene never opens a window
+// or runs a loop of its own, it only reacts to what main() hands it each frame.
+class Scene {
+public:
+    virtual ~Scene() = default;
+
+    // Called whenever the scene becomes the top of the stack, including when the
+    // scene above it is popped; size the window and refresh anything shown here
+    virtual void enter(sf::RenderWindow& window) = 0;
+    virtual void handleEvent(const sf::Event& event) = 0;
+    virtual void update(float dt) { (void)dt; }
+    virtual void render(sf::RenderWindow& window) = 0;   // clears and draws; main() displays
+    // Called once, just before the scene is popped and destroyed
+    virtual void exit() {}
+
+    // Redraw on demand. main() renders only when the scene is dirty: entering it and
+    // every input event mark it, and timers or animations call redraw() from update().
+    // While it is clean main() sleeps until the next event or until wakeAfter() has
+    // passed, then calls update() again.
+    static inline const sf::Time WAIT_FOR_INPUT = sf::seconds(-1.f);
+    virtual sf::Time wakeAfter() const { return WAIT_FOR_INPUT; }   // Zero: every frame
+
+    void redraw() { dirty = true; }
+    bool needsRedraw() const { return dirty; }
+    bool takeRedraw() { bool was = dirty; dirty = false; return was; }
+
+protected:
+    SceneStack& scenes() { return *stack; }
+
+private:
+    friend class SceneStack;
+    SceneStack* stack = nullptr;
+    bool dirty = true;
+};
+
+// Scenes push, pop and replace each other through this. Requests made while a
+// frame is running are applied by main() between frames, so a scene is never
+// destroyed while one of its own member functions is still on the call stack.
+class SceneStack {
+public:
+    void push(std::unique_ptr<Scene> scene);      // a null scene is ignored
+    void pop();
+    void replace(std::unique_ptr<Scene> scene);   // pop then push, as one switch
+    void clear();                                 // leave every scene; ends the app
+
+    bool empty() const { return scenes.empty(); }
+    std::size_t size() const { return scenes.size(); }
+    bool changing() const { return !pending.empty(); }
+    Scene& top() { return *scenes.back(); }
+
+    // Runs the queued changes; returns true if the top scene changed
+    bool applyChanges(sf::RenderWindow& window);
+
+private:
+    enum ChangeType { PUSH, POP, CLEAR };
+    struct Change {
+        ChangeType type;
+        std::unique_ptr<Scene> scene;
+    };
+
+    std::vector<std::unique_ptr<Scene>> scenes;
+    std::vector<Change> pending;
+};
+
+// Resizes the shared window for a scene and resets its view to match, so scene
+// coordinates stay window pixels. The GL context is kept.
+void fitWindow(sf::RenderWindow& window, unsigned width, unsigned height, const char* title);
+
+#endif // SCENE_HPP
@@ -1,4 +1,9 @@
 #include "Snake.hpp"
+#include "core/snake_autopilot.hpp"
+#include "tile_batch.hpp"
+#include "text_cache.hpp"
+#include "alloc_counter.hpp"
+#include "assets.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <vector>
@@ -8,103 +13,22 @@
 #include <string>
 #include <algorithm>
 
-SnakeSegment::SnakeSegment(int x, int y) : x(x), y(y) {}
-
-Snake::Snake() {
-    segments.push_back(SnakeSegment(10, 10));
-    dir = RIGHT;
-}
-
-void Snake::move() {
-    for (int i = segments.size() - 1; i > 0; --i)
-        segments[i] = segments[i - 1];
-
-    switch (dir) {
-    case UP:    segments[0].y -= 1; break;
-    case DOWN:  segments[0].y += 1; break;
-    case LEFT:  segments[0].x -= 1; break;
-    case RIGHT: segments[0].x += 1; break;
-    }
-}
-
-void Snake::grow() {
-    segments.push_back(segments.back());
-}
-
-bool Snake::checkCollision() const {
-    for (size_t i = 1; i < segments.size(); ++i)
-        if (segments[i].x == segments[0].x && segments[i].y == segments[0].y)
-            return true;
-    return false;
-}
-
-void Snake::setDirection(Direction d) {
-    if ((dir == UP && d != DOWN) || (dir == DOWN && d != UP) ||
-        (dir == LEFT && d != RIGHT) || (dir == RIGHT && d != LEFT))
-        dir = d;
-}
-
-// Food generator that never appears in walls
-sf::Vector2i generateFoodPosition(const Snake& snake) {
-    sf::Vector2i pos;
-    bool onSnake;
-    int maxX = (width / blockSize) - 3;
-    int maxY = (height / blockSize) - 4;
-    do {
-        onSnake = false;
-        pos.x = rand() % maxX + 1;
-        pos.y = rand() % maxY + 3; // leaving top bar and bottom border
-        for (auto& s : snake.segments) {
-            if (s.x == pos.x && s.y == pos.y) {
-                onSnake = true;
-                break;
-            }
-        }
-    } while (onSnake);
-    return pos;
-}
-
-// Booster generator (similar to food)
-sf::Vector2i generateBoosterPosition(const Snake& snake) {
-    sf::Vector2i pos;
-    bool onSnake;
-    int maxX = (width / blockSize) - 3;
-    int maxY = (height / blockSize) - 4;
-    do {
-        onSnake = false;
-        pos.x = rand() % maxX + 1;
-        pos.y = rand() % maxY + 3;
-        for (auto& s : snake.segments) {
-            if (s.x == pos.x && s.y == pos.y) {
-                onSnake = true;
-                break;
-            }
-        }
-    } while (onSnake);
-    return pos;
-}
-
-void drawBorder(sf::RenderWindow& window, sf::RectangleShape& block) {
-    block.setFillColor(sf::Color(139, 69, 19)); // Brick color
+// Bricks around the playfield; built once into a static batch
+void buildBorder(TileBatch& bricks) {
+    const sf::Color brick(139, 69, 19);
+    const float size = blockSize - 1;
 
     int wBlocks = width / blockSize;
     int hBlocks = height / blockSize;
 
     for (int x = 0; x < wBlocks; ++x) {
-        block.setPosition(x * blockSize, 2 * blockSize);
-        window.draw(block);
-    }
-
-    for (int x = 0; x < wBlocks; ++x) {
-        block.setPosition(x * blockSize, (hBlocks - 1) * blockSize);
-        window.draw(block);
+        bricks.addRect(x * blockSize, 2 * blockSize, size, size, brick);
+        bricks.addRect(x * blockSize, (hBlocks - 1) * blockSize, size, size, brick);
     }
 
     for (int y = 3; y < hBlocks - 1; ++y) {
-        block.setPosition(0, y * blockSize);
-        window.draw(block);
-        block.setPosition((wBlocks - 1) * blockSize, y * blockSize);
-        window.draw(block);
+        bricks.addRect(0, y * blockSize, size, size, brick);
+        bricks.addRect((wBlocks - 1) * blockSize, y * blockSize, size, size, brick);
     }
 }
 
@@ -118,29 +42,30 @@ void saveScore(int score) {
 }
 
 // Display scores
-void displaySnakeScores() {
-    sf::RenderWindow window(sf::VideoMode(400, 300), "Snake Scores");
-    sf::Font font;
-    if (!font.loadFromFile("arial.ttf")) return;
-
-    std::ifstream inFile("snake_scores.txt");
-    std::string line;
-    std::vector<int> scores;
-    if (inFile.is_open()) {
-        while (std::getline(inFile, line)) {
-            try { scores.push_back(std::stoi(line.substr(line.find(":") + 1))); }
-            catch (...) {}
+class SnakeScoresScene : public Scene {
+public:
+    explicit SnakeScoresScene(const sf::Font& font) : font(font) {}
+
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, 400, 300, "Snake Scores");
+
+        std::ifstream inFile("snake_scores.txt");
+        std::string line;
+        scores.clear();
+        if (inFile.is_open()) {
+            while (std::getline(inFile, line)) {
+                try { scores.push_back(std::stoi(line.substr(line.find(":") + 1))); }
+                catch (...) {}
+            }
+            inFile.close();
         }
-        inFile.close();
-    }
 
-    std::sort(scores.begin(), scores.end(), std::greater<int>());
+        std::sort(scores.begin(), scores.end(), std::greater<int>());
+    }
 
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event))
-            if (event.type == sf::Event::Closed) window.close();
+    void handleEvent(const sf::Event&) override {}
 
+    void render(sf::RenderWindow& window) override {
         window.clear(sf::Color::Black);
         sf::Text title("Snake Scores", font, 30);
         title.setFillColor(sf::Color::White);
@@ -164,187 +89,187 @@ void displaySnakeScores() {
             noScores.setPosition(50, 150);
             window.draw(noScores);
         }
-        window.display();
     }
-}
 
-void playSnake() {
-    sf::RenderWindow window(sf::VideoMode(width, height), "Snake Game");
-    window.setFramerateLimit(60);
-    srand(static_cast<unsigned>(time(0)));
+private:
+    const sf::Font& font;
+    std::vector<int> scores;
+};
+
+class SnakeScene : public Scene {
+public:
+    explicit SnakeScene(const sf::Font& font)
+        : font(font), game(width / blockSize, height / blockSize), snake(game.snake),
+          scoreText(font, 24, 6, "Score: "), finalScore(font, 30, 6, "Final Score: "),
+          overlay(sf::Vector2f(width, 200)), allocWatch("snake") {
+        // Sounds, decoded once per run
+        if (const sf::SoundBuffer* buffer = Assets::sound("food.mp3"))
+            foodSound.setBuffer(*buffer);
+        if (const sf::SoundBuffer* buffer = Assets::sound("gameover.mp3"))
+            gameOverSound.setBuffer(*buffer);
 
-    sf::Font font;
-    if (!font.loadFromFile("arial.ttf")) return;
+        scoreText.setFillColor(sf::Color::White);
+        scoreText.setPosition(10, 2);
+        finalScore.setFillColor(sf::Color::Black);
+        overlay.setFillColor(sf::Color(255, 255, 255, 200));
+        overlay.setPosition(0, 200);
 
-    // Sounds
-    sf::SoundBuffer foodBuffer, gameOverBuffer;
-    sf::Sound foodSound, gameOverSound;
-    foodBuffer.loadFromFile("food.mp3");
-    gameOverBuffer.loadFromFile("gameover.mp3");
-    foodSound.setBuffer(foodBuffer);
-    gameOverSound.setBuffer(gameOverBuffer);
+        restart();
+    }
 
-    bool gameOver = false;
-    bool gameOverSoundPlayed = false;
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, width, height, "Snake Game");
+    }
 
-    Snake snake;
-    sf::Vector2i food = generateFoodPosition(snake);
-
-    // Booster handling
-    sf::Vector2i booster(-1, -1);
-    bool speedBoosterActive = false;
-    bool pointBoosterActive = false;
-    bool useSpeedBoosterNext = true; // alternate boosters
-
-    sf::RectangleShape block(sf::Vector2f(blockSize - 1, blockSize - 1));
-    int score = 0;
-    float baseSpeed = 0.2f;
-    int speedLevel = 0;
-    const int speedIncreaseInterval = 3;
-    const int maxSpeedLevel = 5;
-    float moveTimer = 0.f;
-    sf::Clock clock;
-
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
-
-            if (gameOver) {
-                if (event.type == sf::Event::KeyPressed) {
-                    if (event.key.code == sf::Keyboard::Enter) {
-                        // Restart
-                        saveScore(score);
-                        playSnake();
-                        return;
-                    } else if (event.key.code == sf::Keyboard::Escape) {
-                        saveScore(score);
-                        window.close();
-                    }
-                }
-            } else {
-                if (event.type == sf::Event::KeyPressed) {
-                    switch (event.key.code) {
-                    case sf::Keyboard::W: case sf::Keyboard::Up:    snake.setDirection(UP); break;
-                    case sf::Keyboard::S: case sf::Keyboard::Down:  snake.setDirection(DOWN); break;
-                    case sf::Keyboard::A: case sf::Keyboard::Left:  snake.setDirection(LEFT); break;
-                    case sf::Keyboard::D: case sf::Keyboard::Right: snake.setDirection(RIGHT); break;
-                    default: break;
-                    }
-                }
-            }
-        }
+    void handleEvent(const sf::Event& event) override {
+        if (event.type != sf::Event::KeyPressed) return;
 
-        float currentSpeed = std::max(0.05f, baseSpeed - 0.02f * speedLevel);
-        float deltaTime = clock.restart().asSeconds();
-        moveTimer += deltaTime;
-
-        if (!gameOver && moveTimer >= currentSpeed) {
-            moveTimer = 0.f;
-            snake.move();
-
-            if (snake.segments[0].x < 2 || snake.segments[0].x >= (width / blockSize) - 2 ||
-                snake.segments[0].y < 2 || snake.segments[0].y >= (height / blockSize) - 2 ||
-                snake.checkCollision()) {
-                if (!gameOverSoundPlayed) {
-                    gameOverSound.play();
-                    gameOverSoundPlayed = true;
-                }
-                saveScore(score);
-                gameOver = true;
+        if (game.gameOver) {
+            if (event.key.code == sf::Keyboard::Enter) {
+                saveScore(game.score);
+                restart();
             }
+            return;
+        }
 
-            // Food collision
-            if (!gameOver && snake.segments[0].x == food.x && snake.segments[0].y == food.y) {
-                snake.grow();
-                score++;
-                foodSound.play();
-                food = generateFoodPosition(snake);
-
-                // Check for booster spawn
-                if (score % 10 == 0) {
-                    booster = generateBoosterPosition(snake);
-                    speedBoosterActive = useSpeedBoosterNext;
-                    pointBoosterActive = !useSpeedBoosterNext;
-                    useSpeedBoosterNext = !useSpeedBoosterNext;
-                }
-
-                if (score % speedIncreaseInterval == 0 && speedLevel < maxSpeedLevel)
-                    speedLevel++;
-            }
+        switch (event.key.code) {
+        case sf::Keyboard::W: case sf::Keyboard::Up:    game.apply(UP); break;
+        case sf::Keyboard::S: case sf::Keyboard::Down:  game.apply(DOWN); break;
+        case sf::Keyboard::A: case sf::Keyboard::Left:  game.apply(LEFT); break;
+        case sf::Keyboard::D: case sf::Keyboard::Right: game.apply(RIGHT); break;
+        case sf::Keyboard::P:
+            // Toggle the computer driver
+            autopilotOn = !autopilotOn;
+            game.setAutopilot(autopilotOn ? &autopilot : nullptr);
+            break;
+        default: break;
+        }
+    }
 
-            // Booster collision
-            if (booster.x == snake.segments[0].x && booster.y == snake.segments[0].y) {
-                if (speedBoosterActive) {
-                    if (speedLevel < maxSpeedLevel) speedLevel++;
-                }
-                if (pointBoosterActive) score += 5;
-                booster = sf::Vector2i(-1, -1);
-                speedBoosterActive = pointBoosterActive = false;
+    void update(float dt) override {
+        allocWatch.frameStart();
+        if (!game.gameOver)
+            redraw();   // moving, so every frame is drawn
+        int events = game.step(dt);
+        if (events & core::SNAKE_ATE)
+            foodSound.play();
+        if (events & (core::SNAKE_DIED | core::SNAKE_WON)) {
+            if (!gameOverSoundPlayed) {
+                gameOverSound.play();
+                gameOverSoundPlayed = true;
             }
+            saveScore(game.score);
         }
+    }
 
+    void render(sf::RenderWindow& window) override {
         window.clear(sf::Color::Black);
 
-        // Score bar
-        sf::RectangleShape scoreBar(sf::Vector2f(width, blockSize));
-        scoreBar.setFillColor(sf::Color(50, 50, 50));
-        scoreBar.setPosition(0, 0);
-        window.draw(scoreBar);
+        scoreText.setValue(game.score);
 
-        sf::Text scoreText;
-        scoreText.setFont(font);
-        scoreText.setString("Score: " + std::to_string(score));
-        scoreText.setCharacterSize(24);
-        scoreText.setFillColor(sf::Color::White);
-        scoreText.setPosition(10, 2);
+        if (border.dirty()) {
+            TileBatch& bricks = border.edit();
+            bricks.addRect(0, 0, width, blockSize, sf::Color(50, 50, 50));    // score bar
+            buildBorder(bricks);
+            border.upload();
+        }
+        window.draw(border);
         window.draw(scoreText);
+        if (autopilotOn) {
+            sf::Text& label = texts.get(font, "Autopilot (P)", 24);
+            label.setFillColor(sf::Color::White);
+            label.setPosition(width - label.getLocalBounds().width - 10, 2);
+            window.draw(label);
+        }
 
-        drawBorder(window, block);
-
-        // Draw snake
-        block.setFillColor(sf::Color::Green);
-        for (auto& s : snake.segments) {
-            block.setPosition(s.x * blockSize, s.y * blockSize);
-            window.draw(block);
+        // Snake, each segment eased from its previous cell, then food and booster
+        tiles.clear();
+        float alpha = game.interpolation();
+        for (int i = 0; i < static_cast<int>(snake.segments.size()); ++i) {
+            const SnakeSegment& s = snake.segments[i];
+            SnakeSegment p = snake.previous(i);
+            tiles.addRect((p.x + (s.x - p.x) * alpha) * blockSize,
+                          (p.y + (s.y - p.y) * alpha) * blockSize, tileSize, tileSize, sf::Color::Green);
         }
 
-        // Draw food
-        block.setFillColor(sf::Color::Red);
-        block.setPosition(food.x * blockSize, food.y * blockSize);
-        window.draw(block);
+        if (game.food.x != -1)
+            tiles.addRect(game.food.x * blockSize, game.food.y * blockSize, tileSize, tileSize, sf::Color::Red);
 
-        // Draw booster
-        if (booster.x != -1) {
-            block.setFillColor(speedBoosterActive ? sf::Color::Blue : sf::Color::Yellow);
-            block.setPosition(booster.x * blockSize, booster.y * blockSize);
-            window.draw(block);
-        }
+        if (game.booster.x != -1)
+            tiles.addRect(game.booster.x * blockSize, game.booster.y * blockSize, tileSize, tileSize,
+                game.speedBoosterActive ? sf::Color::Blue : sf::Color::Yellow);
+        window.draw(tiles);
 
-        if (gameOver) {
-            sf::RectangleShape overlay(sf::Vector2f(width, 200));
-            overlay.setFillColor(sf::Color(255, 255, 255, 200));
-            overlay.setPosition(0, 200);
+        if (game.gameOver) {
             window.draw(overlay);
 
-            sf::Text msg("Game Over", font, 50);
-            msg.setFillColor(sf::Color::Red);
+            sf::Text& msg = texts.get(font, game.won ? "You Win!" : "Game Over", 50);
+            msg.setFillColor(game.won ? sf::Color(0, 150, 0) : sf::Color::Red);
             msg.setStyle(sf::Text::Bold);
             msg.setPosition((width - msg.getLocalBounds().width) / 2, 210);
             window.draw(msg);
 
-            sf::Text finalScore("Final Score: " + std::to_string(score), font, 30);
-            finalScore.setFillColor(sf::Color::Black);
+            finalScore.setValue(game.score);
             finalScore.setPosition((width - finalScore.getLocalBounds().width) / 2, 270);
             window.draw(finalScore);
 
-            sf::Text restart("Press 'Enter' to Restart or Esc to Exit", font, 25);
+            sf::Text& restart = texts.get(font, "Press 'Enter' to Restart or Esc to Exit", 25);
             restart.setFillColor(sf::Color::Black);
             restart.setPosition((width - restart.getLocalBounds().width) / 2, 320);
             window.draw(restart);
         }
+        allocWatch.frameEnd();
+    }
+
+    // Runs at the display rate while playing; the game-over screen is static
+    sf::Time wakeAfter() const override {
+        return game.gameOver ? WAIT_FOR_INPUT : sf::Time::Zero;
+    }
 
-        window.display();
+    void exit() override {
+        if (game.gameOver)
+            saveScore(game.score);
     }
+
+private:
+    // A new round reuses the board, sounds and batches; only the rules state resets
+    void restart() {
+        game.reset(static_cast<uint32_t>(time(0)));
+        game.setAutopilot(autopilotOn ? &autopilot : nullptr);
+        gameOverSoundPlayed = false;
+    }
+
+    const sf::Font& font;
+    sf::Sound foodSound, gameOverSound;
+    bool gameOverSoundPlayed = false;
+
+    core::SnakeGame game;
+    core::SnakeAutopilot autopilot;
+    bool autopilotOn = false;
+    const Snake& snake;
+
+    // Two draw calls for the whole field: the static border and everything that moves
+    StaticTileBatch border;
+    TileBatch tiles;
+    const float tileSize = blockSize - 1;
+
+    // Labels are built once; the score digits are rewritten in place
+    TextCache texts;
+    NumberText scoreText;
+    NumberText finalScore;
+    sf::RectangleShape overlay;
+
+    debug::FrameAllocations allocWatch;
+};
+
+std::unique_ptr<Scene> makeSnakeScene() {
+    const sf::Font* font = Assets::font("arial.ttf");
+    if (!font) return nullptr;
+    return std::make_unique<SnakeScene>(*font);
+}
+
+std::unique_ptr<Scene> makeSnakeScoresScene() {
+    const sf::Font* font = Assets::font("arial.ttf");
+    if (!font) return nullptr;
+    return std::make_unique<SnakeScoresScene>(*font);
 }
@@ -0,0 +1,126 @@
+#include "text_cache.hpp"
+#include <algorithm>
+
+sf::Text& TextCache::get(const sf::Font& font, std::string_view str, unsigned size) {
+    auto it = texts.find(KeyView{ &font, size, str });
+    if (it == texts.end())
+        it = texts.emplace(Key{ &font, size, std::string(str) },
+            sf::Text(sf::String(std::string(str)), font, size)).first;
+    return it->second;
+}
+
+NumberText::NumberText(const sf::Font& font, unsigned size, int maxDigits,
+    std::string_view prefix, std::string_view suffix)
+    : font(&font), size(size), maxDigits(maxDigits), prefix(prefix), suffix(suffix),
+      digitAdvance(0), prefixWidth(0), color(sf::Color::White),
+      verts(sf::Triangles, (prefix.size() + maxDigits + suffix.size()) * 6) {
+    for (char d = '0'; d <= '9'; ++d)
+        digitAdvance = std::max(digitAdvance, font.getGlyph(d, size, false).advance);
+
+    for (std::size_t i = 0; i < this->prefix.size(); ++i) {
+        placeGlyph(i, static_cast<unsigned char>(this->prefix[i]), prefixWidth);
+        prefixWidth += font.getGlyph(static_cast<unsigned char>(this->prefix[i]), size, false).advance;
+    }
+    setValue(0);
+}
+
+// One quad per character; spaces collapse to a point on the baseline
+void NumberText::placeGlyph(std::size_t quad, sf::Uint32 ch, float x) {
+    sf::Vertex* v = &verts[quad * 6];
+    if (ch == ' ') {
+        for (int i = 0; i < 6; ++i)
+            v[i] = sf::Vertex(sf::Vector2f(x, static_cast<float>(size)), color);
+        return;
+    }
+    const sf::Glyph& g = font->getGlyph(ch, size, false);
+    float left = x + g.bounds.left, top = size + g.bounds.top;
+    float right = left + g.bounds.width, bottom = top + g.bounds.height;
+    float u0 = static_cast<float>(g.textureRect.left), v0 = static_cast<float>(g.textureRect.top);
+    float u1 = u0 + g.textureRect.width, v1 = v0 + g.textureRect.height;
+    v[0] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u0, v0));
+    v[1] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u1, v0));
+    v[2] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u1, v1));
+    v[3] = v[0];
+    v[4] = v[2];
+    v[5] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u0, v1));
+}
+
+// Digits sit centred in their slots; the suffix follows the last one used
+void NumberText::layout(const char* digits, int count) {
+    std::size_t first = prefix.size();
+    for (int k = 0; k < maxDigits; ++k) {
+        float x = prefixWidth + k * digitAdvance;
+        if (k < count && digits[k] != ' ') {
+            float adv = font->getGlyph(static_cast<unsigned char>(digits[k]), size, false).advance;
+            placeGlyph(first + k, static_cast<unsigned char>(digits[k]), x + (digitAdvance - adv) / 2.f);
+        } else {
+            placeGlyph(first + k, ' ', x);
+        }
+    }
+
+    float penX = prefixWidth + count * digitAdvance;
+    first += maxDigits;
+    for (std::size_t i = 0; i < suffix.size(); ++i) {
+        placeGlyph(first + i, static_cast<unsigned char>(suffix[i]), penX);
+        penX += font->getGlyph(static_cast<unsigned char>(suffix[i]), size, false).advance;
+    }
+
+    // Bounds of the quads in use, leaving out empty digit slots, measured the way
+    // sf::Text does: glyph boxes, with a space only stretching the width by its advance
+    float minX = static_cast<float>(size), minY = static_cast<float>(size), maxX = 0.f, maxY = 0.f;
+    float spaceAdvance = font->getGlyph(' ', size, false).advance;
+    std::size_t used = prefix.size() + count;
+    for (std::size_t quad = 0; quad < prefix.size() + maxDigits + suffix.size(); ++quad) {
+        if (quad >= used && quad < prefix.size() + maxDigits) continue;
+        const sf::Vertex* v = &verts[quad * 6];
+        if (v[0].position == v[2].position) {
+            maxX = std::max(maxX, v[0].position.x + spaceAdvance);
+            continue;
+        }
+        minX = std::min(minX, v[0].position.x);
+        minY = std::min(minY, v[0].position.y);
+        maxX = std::max(maxX, v[2].position.x);
+        maxY = std::max(maxY, v[2].position.y);
+    }
+    if (minY > maxY)        // nothing but spaces
+        minX = minY = maxY = 0.f;
+    bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+void NumberText::setValue(long long value) {
+    char buf[24];
+    int n = 0;
+    bool negative = value < 0;
+    unsigned long long v = negative ? 0ull - static_cast<unsigned long long>(value) : value;
+    do {
+        buf[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v && n < 20);
+    if (negative) buf[n++] = '-';
+    std::reverse(buf, buf + n);
+
+    // Too wide for the label: keep the low digits
+    int skip = std::max(0, n - maxDigits);
+    layout(buf + skip, n - skip);
+}
+
+void NumberText::setText(std::string_view text) {
+    int n = std::min(static_cast<int>(text.size()), maxDigits);
+    layout(text.data(), n);
+}
+
+void NumberText::setFillColor(const sf::Color& c) {
+    color = c;
+    for (std::size_t i = 0; i < verts.getVertexCount(); ++i)
+        verts[i].color = c;
+}
+
+sf::FloatRect NumberText::getLocalBounds() const {
+    return bounds;
+}
+
+void NumberText::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    states.transform *= getTransform();
+    states.texture = &font->getTexture(size);
+    target.draw(verts, states);
+}
@@ -0,0 +1,72 @@
+#ifndef TEXT_CACHE_HPP
+#define TEXT_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <string>
+#include <string_view>
+
+// Pre-built sf::Text objects keyed by (string, size, font). The first get() for a key
+// builds the text; later ones find it without creating a std::string, so labels that
+// come from a small set (messages, prompts, digits) cost nothing per frame.
+// Callers may restyle or move the returned text; it stays in the cache.
+class TextCache {
+public:
+    sf::Text& get(const sf::Font& font, std::string_view str, unsigned size);
+    void clear() { texts.clear(); }
+    std::size_t size() const { return texts.size(); }
+
+private:
+    struct Key {
+        const sf::Font* font;
+        unsigned size;
+        std::string str;
+    };
+    struct KeyView {
+        const sf::Font* font;
+        unsigned size;
+        std::string_view str;
+    };
+    struct Less {
+        using is_transparent = void;
+        template<class A, class B>
+        bool operator()(const A& a, const B& b) const {
+            if (a.font != b.font) return a.font < b.font;
+            if (a.size != b.size) return a.size < b.size;
+            return std::string_view(a.str) < std::string_view(b.str);
+        }
+    };
+
+    std::map<Key, sf::Text, Less> texts;
+};
+
+// A number with an optional fixed prefix and suffix ("Time: ", "s"). Every digit
+// slot is as wide as the widest digit so the label does not jitter, and
+// setValue() only rewrites the existing glyph quads, so it never allocates.
+class NumberText : public sf::Drawable, public sf::Transformable {
+public:
+    NumberText(const sf::Font& font, unsigned size, int maxDigits,
+        std::string_view prefix = "", std::string_view suffix = "");
+
+    void setValue(long long value);
+    void setText(std::string_view text);    // any short text ("N/A") in the digit slots
+    void setFillColor(const sf::Color& color);
+    sf::FloatRect getLocalBounds() const;
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void placeGlyph(std::size_t quad, sf::Uint32 ch, float x);
+    void layout(const char* digits, int count);
+
+    const sf::Font* font;
+    unsigned size;
+    int maxDigits;
+    std::string prefix, suffix;
+    float digitAdvance;
+    float prefixWidth;
+    sf::Color color;
+    sf::VertexArray verts;  // prefix quads, then maxDigits slots, then suffix quads
+    sf::FloatRect bounds;   // of the characters laid out, not the unused slots
+};
+
+#endif // TEXT_CACHE_HPP
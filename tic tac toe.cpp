@@ -1,36 +1,28 @@
 #include "TicTacToe.hpp"
+#include "core/tictactoe_solver.hpp"
+#include "core/mnk_engine.hpp"
+#include "assets.hpp"
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <ctime>
+#include <memory>
 
-char board[3][3];
-char currentPlayer = 'X';
 int playerWins = 0, computerWins = 0, draws = 0;
 
-void initializeBoard() {
-    char num = '1';
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            board[i][j] = num++;
-}
-
-bool isWinner(char symbol) {
-    for (int i = 0; i < 3; i++)
-        if ((board[i][0] == symbol && board[i][1] == symbol && board[i][2] == symbol) ||
-            (board[0][i] == symbol && board[1][i] == symbol && board[2][i] == symbol))
-            return true;
+const char* difficultyNames[] = { "Easy", "Medium", "Hard", "Perfect" };
 
-    return (board[0][0] == symbol && board[1][1] == symbol && board[2][2] == symbol) ||
-        (board[0][2] == symbol && board[1][1] == symbol && board[2][0] == symbol);
-}
+// Board sizes cycled with 'M'; mode 0 is the classic board played from the solved table
+const char* modeNames[] = { "3x3", "7x7, 4 in a row", "15x15, 5 in a row" };
+const int MODE_COUNT = 3;
 
-bool isDraw() {
-    for (int i = 0; i < 3; i++)
-        for (int j = 0; j < 3; j++)
-            if (board[i][j] != 'X' && board[i][j] != 'O')
-                return false;
-    return true;
+std::unique_ptr<core::MnkGameBase> makeMnkGame(int mode) {
+    switch (mode) {
+    case 1:  return std::unique_ptr<core::MnkGameBase>(new core::MnkGame<7, 7, 4>(5, 10));
+    case 2:  return std::unique_ptr<core::MnkGameBase>(new core::MnkGame<15, 15, 5>(4, 8));
+    default: return nullptr;
+    }
 }
 
 void saveScores() {
@@ -58,7 +50,7 @@ sf::Vector2i getBoardPosition(int x, int y) {
     return { x / 200, y / 200 };
 }
 
-void drawBoard(sf::RenderWindow& window, sf::Font& font) {
+void drawBoard(sf::RenderWindow& window, const sf::Font& font, const core::TicTacToeGame& game) {
     for (int i = 1; i < 3; ++i) {
         sf::RectangleShape lineH(sf::Vector2f(600, 5));
         lineH.setPosition(0, i * 200);
@@ -73,80 +65,143 @@ void drawBoard(sf::RenderWindow& window, sf::Font& font) {
 
     for (int i = 0; i < 3; ++i)
         for (int j = 0; j < 3; ++j)
-            if (board[i][j] == 'X' || board[i][j] == 'O') {
-                sf::Text mark(board[i][j], font, 120);
+            if (!game.isFree(i, j)) {
+                sf::Text mark(game.board[i][j], font, 120);
                 mark.setFillColor(sf::Color::Blue);
                 mark.setPosition(j * 200 + 60, i * 200 + 40);
                 window.draw(mark);
             }
 }
 
-bool handlePlayerClick(int x, int y) {
+bool handlePlayerClick(core::TicTacToeGame& game, int x, int y) {
     sf::Vector2i pos = getBoardPosition(x, y);
-    int row = pos.y;
-    int col = pos.x;
-    if (row < 3 && col < 3 && board[row][col] != 'X' && board[row][col] != 'O') {
-        board[row][col] = currentPlayer;
-        return true;
+    return game.apply(pos.y, pos.x);
+}
+
+// The computer plays 'O' straight from the solved table
+void computerMove(core::TicTacToeGame& game, core::TicTacToeSolver::Difficulty difficulty, core::Rng& rng) {
+    int cell = core::TicTacToeSolver::chooseMove(game, difficulty, rng);
+    if (cell >= 0)
+        game.apply(cell / 3, cell % 3);
+}
+
+void drawMnkBoard(sf::RenderWindow& window, const sf::Font& font, const core::MnkGameBase& game) {
+    float cell = 600.f / game.cols();
+    for (int i = 1; i < game.cols(); ++i) {
+        sf::RectangleShape lineH(sf::Vector2f(600, 2));
+        lineH.setPosition(0, i * cell);
+        lineH.setFillColor(sf::Color::Black);
+        window.draw(lineH);
+
+        sf::RectangleShape lineV(sf::Vector2f(2, 600));
+        lineV.setPosition(i * cell, 0);
+        lineV.setFillColor(sf::Color::Black);
+        window.draw(lineV);
     }
-    return false;
+
+    sf::Text mark("", font, static_cast<unsigned>(cell * 0.8f));
+    for (int i = 0; i < game.rows(); ++i)
+        for (int j = 0; j < game.cols(); ++j)
+            if (game.at(i, j) != ' ') {
+                mark.setString(game.at(i, j));
+                mark.setFillColor(game.at(i, j) == 'X' ? sf::Color::Blue : sf::Color::Red);
+                sf::FloatRect bounds = mark.getLocalBounds();
+                mark.setOrigin(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+                mark.setPosition(j * cell + cell / 2.f, i * cell + cell / 2.f);
+                window.draw(mark);
+            }
 }
 
-void playTicTacToe() {
-    sf::RenderWindow window(sf::VideoMode(600, 700), "Tic-Tac-Toe SFML");
-    sf::Font font;
-    if (!font.loadFromFile("arial.ttf")) {
-        std::cerr << "Font loading failed.\n";
-        return;
+void recordResult(char winner, std::string& message) {
+    if (winner) {
+        message = (winner == 'X') ? "Player Wins!" : "Computer Wins!";
+        if (winner == 'X') playerWins++;
+        else computerWins++;
+    }
+    else {
+        message = "It's a Draw!";
+        draws++;
     }
+    saveScores();
+}
 
-    loadScores();
-    initializeBoard();
+class TicTacToeScene : public Scene {
+public:
+    explicit TicTacToeScene(const sf::Font& font)
+        : font(font), rng(static_cast<uint64_t>(time(nullptr))), difficultyText("", font, 24) {
+        loadScores();
+        difficultyText.setFillColor(sf::Color::Black);
+        difficultyText.setPosition(20, 640);
+    }
 
-    bool gameOver = false;
-    std::string message;
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, 600, 700, "Tic-Tac-Toe SFML");
+    }
 
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
-
-            if (!gameOver && event.type == sf::Event::MouseButtonPressed &&
-                event.mouseButton.button == sf::Mouse::Left) {
-                if (handlePlayerClick(event.mouseButton.x, event.mouseButton.y)) {
-                    if (isWinner(currentPlayer)) {
-                        message = (currentPlayer == 'X') ? "Player Wins!" : "Computer Wins!";
-                        if (currentPlayer == 'X') playerWins++;
-                        else computerWins++;
-                        saveScores();
-                        gameOver = true;
-                    }
-                    else if (isDraw()) {
-                        message = "It's a Draw!";
-                        draws++;
-                        saveScores();
-                        gameOver = true;
-                    }
-                    else {
-                        currentPlayer = (currentPlayer == 'X') ? 'O' : 'X';
-                    }
-                }
+    void handleEvent(const sf::Event& event) override {
+        if (!mnk && !game.gameOver && event.type == sf::Event::MouseButtonPressed &&
+            event.mouseButton.button == sf::Mouse::Left) {
+            if (handlePlayerClick(game, event.mouseButton.x, event.mouseButton.y)) {
+                if (!game.gameOver)
+                    computerMove(game, difficulty, rng);
+                if (game.gameOver)
+                    recordResult(game.winner, message);
             }
+        }
 
-            if (gameOver && event.type == sf::Event::KeyPressed &&
-                event.key.code == sf::Keyboard::R) {
-                initializeBoard();
-                currentPlayer = 'X';
-                gameOver = false;
-                message.clear();
+        // Same cell size as drawMnkBoard; clicks on the status text below the board are ignored
+        if (mnk && !mnk->gameOver && event.type == sf::Event::MouseButtonPressed &&
+            event.mouseButton.button == sf::Mouse::Left &&
+            event.mouseButton.x >= 0 && event.mouseButton.x < 600 &&
+            event.mouseButton.y >= 0 && event.mouseButton.y < 600) {
+            float cell = 600.f / mnk->cols();
+            int row = static_cast<int>(event.mouseButton.y / cell);
+            int col = static_cast<int>(event.mouseButton.x / cell);
+            if (mnk->apply(row, col)) {
+                if (!mnk->gameOver) {
+                    int move = mnk->chooseMove();
+                    mnk->apply(move / mnk->cols(), move % mnk->cols());
+                }
+                if (mnk->gameOver)
+                    recordResult(mnk->winner, message);
             }
         }
 
+        // 'M' cycles through the board sizes and starts a fresh game
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::M) {
+            mode = (mode + 1) % MODE_COUNT;
+            mnk = makeMnkGame(mode);
+            game.reset();
+            message.clear();
+        }
+
+        // 1-4 pick the computer's strength
+        if (event.type == sf::Event::KeyPressed &&
+            event.key.code >= sf::Keyboard::Num1 && event.key.code <= sf::Keyboard::Num4) {
+            difficulty = static_cast<core::TicTacToeSolver::Difficulty>(event.key.code - sf::Keyboard::Num1);
+        }
+
+        bool over = mnk ? mnk->gameOver : game.gameOver;
+        if (over && event.type == sf::Event::KeyPressed &&
+            event.key.code == sf::Keyboard::R) {
+            game.reset();
+            if (mnk) mnk->reset();
+            message.clear();
+        }
+    }
+
+    void render(sf::RenderWindow& window) override {
         window.clear(sf::Color::White);
-        drawBoard(window, font);
+        if (mnk)
+            drawMnkBoard(window, font, *mnk);
+        else
+            drawBoard(window, font, game);
+
+        difficultyText.setString(std::string("Board: ") + modeNames[mode] + " ('M')" +
+            (mnk ? "" : std::string("   Computer: ") + difficultyNames[difficulty] + " (1-4)"));
+        window.draw(difficultyText);
 
-        if (gameOver) {
+        if (mnk ? mnk->gameOver : game.gameOver) {
             sf::RectangleShape overlay(sf::Vector2f(600, 200));
             overlay.setFillColor(sf::Color(255, 255, 255, 200));
             overlay.setPosition(0, 250);
@@ -163,45 +218,68 @@ void playTicTacToe() {
             restart.setPosition((600 - restart.getLocalBounds().width) / 2, 330);
             window.draw(restart);
         }
-
-        window.display();
     }
-}
 
-void displayTicTacToeScores() {
-    sf::RenderWindow window(sf::VideoMode(500, 300), "Tic-Tac-Toe Scores");
-    sf::Font font;
-    if (!font.loadFromFile("arial.ttf")) {
-        std::cerr << "Font not found for scores.\n";
-        return;
-    }
+private:
+    const sf::Font& font;
+    core::TicTacToeGame game;
+    core::Rng rng;
+    core::TicTacToeSolver::Difficulty difficulty = core::TicTacToeSolver::PERFECT;
+    int mode = 0;
+    std::unique_ptr<core::MnkGameBase> mnk;
+    sf::Text difficultyText;
+    std::string message;
+};
 
-    loadScores();
+class TicTacToeScoresScene : public Scene {
+public:
+    explicit TicTacToeScoresScene(const sf::Font& font)
+        : title("Tic-Tac-Toe Scores", font, 32), scoreText("", font, 24) {
+        title.setStyle(sf::Text::Bold);
+        title.setFillColor(sf::Color::Blue);
+        title.setPosition(100, 20);
 
-    sf::Text title("Tic-Tac-Toe Scores", font, 32);
-    title.setStyle(sf::Text::Bold);
-    title.setFillColor(sf::Color::Blue);
-    title.setPosition(100, 20);
+        scoreText.setFillColor(sf::Color::Black);
+        scoreText.setPosition(60, 100);
+    }
 
-    sf::Text scoreText("", font, 24);
-    scoreText.setFillColor(sf::Color::Black);
-    scoreText.setPosition(60, 100);
+    void enter(sf::RenderWindow& window) override {
+        fitWindow(window, 500, 300, "Tic-Tac-Toe Scores");
 
-    std::string scoreData = "Player Wins: " + std::to_string(playerWins) + "\n";
-    scoreData += "Computer Wins: " + std::to_string(computerWins) + "\n";
-    scoreData += "Draws: " + std::to_string(draws) + "\n";
-    scoreText.setString(scoreData);
+        loadScores();
+        std::string scoreData = "Player Wins: " + std::to_string(playerWins) + "\n";
+        scoreData += "Computer Wins: " + std::to_string(computerWins) + "\n";
+        scoreData += "Draws: " + std::to_string(draws) + "\n";
+        scoreText.setString(scoreData);
+    }
 
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
-        }
+    void handleEvent(const sf::Event&) override {}
 
+    void render(sf::RenderWindow& window) override {
         window.clear(sf::Color::White);
         window.draw(title);
         window.draw(scoreText);
-        window.display();
     }
+
+private:
+    sf::Text title;
+    sf::Text scoreText;
+};
+
+std::unique_ptr<Scene> makeTicTacToeScene() {
+    const sf::Font* font = Assets::font("arial.ttf");
+    if (!font) {
+        std::cerr << "Font loading failed.\n";
+        return nullptr;
+    }
+    return std::make_unique<TicTacToeScene>(*font);
+}
+
+std::unique_ptr<Scene> makeTicTacToeScoresScene() {
+    const sf::Font* font = Assets::font("arial.ttf");
+    if (!font) {
+        std::cerr << "Font not found for scores.\n";
+        return nullptr;
+    }
+    return std::make_unique<TicTacToeScoresScene>(*font);
 }
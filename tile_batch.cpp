@@ -0,0 +1,136 @@
+#include "tile_batch.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    void pushQuad(sf::VertexArray& verts, float left, float top, float right, float bottom,
+        const sf::Color& color, float u0 = 0, float v0 = 0, float u1 = 0, float v1 = 0) {
+        sf::Vertex a(sf::Vector2f(left, top), color, sf::Vector2f(u0, v0));
+        sf::Vertex b(sf::Vector2f(right, top), color, sf::Vector2f(u1, v0));
+        sf::Vertex c(sf::Vector2f(right, bottom), color, sf::Vector2f(u1, v1));
+        sf::Vertex d(sf::Vector2f(left, bottom), color, sf::Vector2f(u0, v1));
+        verts.append(a); verts.append(b); verts.append(c);
+        verts.append(a); verts.append(c); verts.append(d);
+    }
+
+}
+
+TileBatch::TileBatch() : verts(sf::Triangles) {}
+
+void TileBatch::clear() {
+    verts.clear();  // keeps its capacity, so steady-state frames do not allocate
+}
+
+void TileBatch::addRect(float x, float y, float w, float h, const sf::Color& color) {
+    pushQuad(verts, x, y, x + w, y + h, color);
+}
+
+void TileBatch::addOutlinedRect(float x, float y, float w, float h, const sf::Color& fill,
+    const sf::Color& outline, float thickness) {
+    pushQuad(verts, x - thickness, y - thickness, x + w + thickness, y + h + thickness, outline);
+    pushQuad(verts, x, y, x + w, y + h, fill);
+}
+
+void TileBatch::addTexturedRect(float x, float y, float w, float h, const sf::FloatRect& texRect) {
+    pushQuad(verts, x, y, x + w, y + h, sf::Color::White,
+        texRect.left, texRect.top, texRect.left + texRect.width, texRect.top + texRect.height);
+}
+
+// Same placement as sf::CircleShape: (x, y) is the top-left of the bounding box
+void TileBatch::addCircle(float x, float y, float radius, const sf::Color& color, int points) {
+    const float pi = 3.14159265f;
+    sf::Vector2f center(x + radius, y + radius);
+    for (int i = 0; i < points; ++i) {
+        float a0 = 2 * pi * i / points, a1 = 2 * pi * (i + 1) / points;
+        verts.append(sf::Vertex(center, color));
+        verts.append(sf::Vertex(sf::Vector2f(center.x + radius * std::cos(a0), center.y + radius * std::sin(a0)), color));
+        verts.append(sf::Vertex(sf::Vector2f(center.x + radius * std::cos(a1), center.y + radius * std::sin(a1)), color));
+    }
+}
+
+void TileBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (verts.getVertexCount() > 0)
+        target.draw(verts, states);
+}
+
+StaticTileBatch::StaticTileBatch()
+    : buffer(sf::Triangles, sf::VertexBuffer::Static), useBuffer(sf::VertexBuffer::isAvailable()), needsBuild(true) {}
+
+TileBatch& StaticTileBatch::edit() {
+    batch.clear();
+    return batch;
+}
+
+void StaticTileBatch::upload() {
+    const sf::VertexArray& verts = batch.vertices();
+    std::size_t count = verts.getVertexCount();
+    if (useBuffer && count > 0) {
+        useBuffer = (buffer.getVertexCount() == count || buffer.create(count)) && buffer.update(&verts[0]);
+    }
+    needsBuild = false;
+}
+
+void StaticTileBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (useBuffer && buffer.getVertexCount() > 0)
+        target.draw(buffer, states);
+    else
+        target.draw(batch, states);
+}
+
+TextBatch::TextBatch(const sf::Font& font, unsigned characterSize, bool bold)
+    : font(&font), size(characterSize), bold(bold), verts(sf::Triangles) {}
+
+void TextBatch::clear() {
+    verts.clear();
+}
+
+// sf::Text puts the first baseline one character size below its position
+void TextBatch::add(std::string_view text, float x, float y, const sf::Color& color) {
+    float penX = x, baseline = y + size;
+    sf::Uint32 prev = 0;
+    for (unsigned char ch : text) {
+        penX += font->getKerning(prev, ch, size);
+        prev = ch;
+        const sf::Glyph& g = font->getGlyph(ch, size, bold);
+        float left = penX + g.bounds.left, top = baseline + g.bounds.top;
+        pushQuad(verts, left, top, left + g.bounds.width, top + g.bounds.height, color,
+            static_cast<float>(g.textureRect.left), static_cast<float>(g.textureRect.top),
+            static_cast<float>(g.textureRect.left + g.textureRect.width),
+            static_cast<float>(g.textureRect.top + g.textureRect.height));
+        penX += g.advance;
+    }
+}
+
+sf::FloatRect TextBatch::measure(std::string_view text) const {
+    float penX = 0, minX = 0, minY = 0, maxX = 0, maxY = 0;
+    bool any = false;
+    sf::Uint32 prev = 0;
+    for (unsigned char ch : text) {
+        penX += font->getKerning(prev, ch, size);
+        prev = ch;
+        const sf::Glyph& g = font->getGlyph(ch, size, bold);
+        float left = penX + g.bounds.left, top = size + g.bounds.top;
+        float right = left + g.bounds.width, bottom = top + g.bounds.height;
+        if (!any) {
+            minX = left; minY = top; maxX = right; maxY = bottom;
+            any = true;
+        } else {
+            minX = std::min(minX, left); minY = std::min(minY, top);
+            maxX = std::max(maxX, right); maxY = std::max(maxY, bottom);
+        }
+        penX += g.advance;
+    }
+    return sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+void TextBatch::addCentered(std::string_view text, float cx, float cy, const sf::Color& color) {
+    sf::FloatRect r = measure(text);
+    add(text, cx - (r.left + r.width / 2.f), cy - (r.top + r.height / 2.f), color);
+}
+
+void TextBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (verts.getVertexCount() == 0) return;
+    states.texture = &font->getTexture(size);
+    target.draw(verts, states);
+}
@@ -0,0 +1,71 @@
+#ifndef TILE_BATCH_HPP
+#define TILE_BATCH_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string_view>
+
+// Solid rectangles (and small circles) collected into one vertex array,
+// so a whole grid layer goes to the GPU in a single draw call
+class TileBatch : public sf::Drawable {
+public:
+    TileBatch();
+
+    void clear();
+    void addRect(float x, float y, float w, float h, const sf::Color& color);
+    // Outline drawn outside the rectangle, as sf::Shape does
+    void addOutlinedRect(float x, float y, float w, float h, const sf::Color& fill,
+        const sf::Color& outline, float thickness);
+    void addCircle(float x, float y, float radius, const sf::Color& color, int points = 16);
+    // Shows texRect (in texels) of the texture given in the draw call's render states
+    void addTexturedRect(float x, float y, float w, float h, const sf::FloatRect& texRect);
+
+    const sf::VertexArray& vertices() const { return verts; }
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    sf::VertexArray verts;
+};
+
+// Geometry that rarely changes, such as borders and grid backgrounds.
+// Built through edit(), uploaded to a vertex buffer when the driver supports one,
+// and left alone until invalidate() marks it for rebuilding.
+class StaticTileBatch : public sf::Drawable {
+public:
+    StaticTileBatch();
+
+    bool dirty() const { return needsBuild; }
+    void invalidate() { needsBuild = true; }
+    TileBatch& edit();      // cleared builder; call upload() when done
+    void upload();
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    TileBatch batch;
+    sf::VertexBuffer buffer;
+    bool useBuffer;
+    bool needsBuild;
+};
+
+// Glyph quads for many short labels in one font, size and style; one draw call
+// against the font's glyph page. Positions match what sf::Text would use.
+class TextBatch : public sf::Drawable {
+public:
+    TextBatch(const sf::Font& font, unsigned characterSize, bool bold = false);
+
+    void clear();
+    void add(std::string_view text, float x, float y, const sf::Color& color);
+    void addCentered(std::string_view text, float cx, float cy, const sf::Color& color);
+    sf::FloatRect measure(std::string_view text) const;   // like sf::Text::getLocalBounds
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    const sf::Font* font;
+    unsigned size;
+    bool bold;
+    sf::VertexArray verts;
+};
+
+#endif // TILE_BATCH_HPP
@@ -0,0 +1,122 @@
+// Headless Connect Four search benchmark over a fixed suite of mid-game positions.
+// Usage: connectfour_bench [--time-ms N] [--tt-mb N] [--threads N] [--scaling [--depth N]]
+// --scaling reruns the suite at 1/2/4/8/16 threads, each position searched to a fixed
+// depth (default 20) or until solved, and reports time and nodes to get there against
+// one thread. --time-ms is then only a safety cap, 60 s per position by default.
+#include "core/connectfour_search.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+    // Move sequences, one digit per move, columns numbered 1-7
+    const char* suite[] = {
+        "126675665653",
+        "473223165471",
+        "747763121131",
+        "421612567741",
+        "372267644477",
+        "452622611323",
+        "324623761375",
+        "453133153417",
+    };
+
+    bool loadPosition(const std::string& moves, ConnectFourBoard& board) {
+        board.reset();
+        for (char ch : moves) {
+            int col = ch - '1';
+            if (col < 0 || col >= ConnectFourBoard::COLS || !board.canPlay(col) || board.isWinningMove(col))
+                return false;
+            board.play(col);
+        }
+        return true;
+    }
+
+    struct SuiteTotals {
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+        int solved = 0;
+        int completed = 0;      // reached maxDepth or solved, rather than running out of time
+    };
+
+    const int suiteSize = static_cast<int>(sizeof(suite) / sizeof(suite[0]));
+
+    bool runSuite(ConnectFourSearch& search, int timeMs, int maxDepth, bool verbose, SuiteTotals& totals) {
+        if (verbose)
+            printf("%-14s %5s %6s %6s %12s %8s %10s %6s\n", "position", "move", "score", "depth", "nodes", "secs", "Mnodes/s", "tthit");
+
+        for (const char* moves : suite) {
+            ConnectFourBoard board;
+            if (!loadPosition(moves, board)) {
+                fprintf(stderr, "bad position %s\n", moves);
+                return false;
+            }
+            search.clearTable();
+            SearchResult r = search.search(board, timeMs, maxDepth);
+            if (verbose) {
+                printf("%-14s %5d %6d %5d%c %12llu %8.3f %10.2f %5.1f%%\n", moves, r.move + 1, r.score, r.depth,
+                    r.solved ? '*' : ' ', static_cast<unsigned long long>(r.nodes), r.seconds,
+                    r.nodesPerSecond() / 1e6, 100.0 * r.ttHitRate());
+            }
+            totals.nodes += r.nodes;
+            totals.seconds += r.seconds;
+            totals.solved += r.solved;
+            totals.completed += r.solved || r.depth >= maxDepth;
+        }
+        return true;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    int timeMs = -1;
+    size_t ttMB = 64;
+    int threads = 1;
+    int depth = 20;
+    bool scaling = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--scaling")) scaling = true;
+        else if (i + 1 < argc && !strcmp(argv[i], "--time-ms")) timeMs = atoi(argv[++i]);
+        else if (i + 1 < argc && !strcmp(argv[i], "--depth")) depth = atoi(argv[++i]);
+        else if (i + 1 < argc && !strcmp(argv[i], "--tt-mb")) ttMB = static_cast<size_t>(atoi(argv[++i]));
+        else if (i + 1 < argc && !strcmp(argv[i], "--threads")) threads = atoi(argv[++i]);
+    }
+
+    ConnectFourSearch search(ttMB, threads);
+
+    if (!scaling) {
+        SuiteTotals totals;
+        if (!runSuite(search, timeMs < 0 ? 2000 : timeMs, 64, true, totals)) return 1;
+        printf("threads %d, solved %d/%d, %.2f Mnodes/s overall (* = solved)\n", search.threadCount(),
+            totals.solved, suiteSize, totals.seconds > 0 ? totals.nodes / totals.seconds / 1e6 : 0.0);
+        return 0;
+    }
+
+    // Lazy SMP at a fixed time budget would only search deeper, so scaling is measured
+    // as time to the same result: every position to the same depth or to a proof.
+    // More threads also search more nodes to get there; the node ratio shows the overhead.
+    if (timeMs < 0) timeMs = 60000;
+    printf("depth %d, cap %d ms per position\n", depth, timeMs);
+    printf("%7s %8s %10s %7s %8s %10s %8s\n", "threads", "done", "Mnodes", "nodes", "secs", "Mnodes/s", "speedup");
+    SuiteTotals baseline;
+    const int threadCounts[] = { 1, 2, 4, 8, 16 };
+    for (int t : threadCounts) {
+        search.setThreads(t);
+        SuiteTotals totals;
+        if (!runSuite(search, timeMs, depth, false, totals)) return 1;
+        if (t == 1) baseline = totals;
+        printf("%7d %5d/%-2d %10.2f %6.2fx %8.3f %10.2f %7.2fx\n", t, totals.completed, suiteSize,
+            totals.nodes / 1e6, baseline.nodes ? double(totals.nodes) / baseline.nodes : 0.0, totals.seconds,
+            totals.seconds > 0 ? totals.nodes / totals.seconds / 1e6 : 0.0,
+            totals.seconds > 0 ? baseline.seconds / totals.seconds : 0.0);
+        if (totals.completed < suiteSize)
+            printf("        %d position(s) hit the time cap; raise --time-ms or lower --depth\n",
+                suiteSize - totals.completed);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Offline generator for the Connect Four opening book.
+// Usage: connectfour_book_gen [--ply N] [--time-ms N] [--threads N] [--tt-mb N] [--out FILE]
+// Enumerates every position up to N plies (mirror images folded together), searches
+// each one and writes the sorted binary book that OpeningBook maps at runtime.
+#include "core/connectfour_book.hpp"
+#include "core/connectfour_search.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+    void enumerate(ConnectFourBoard& board, int maxPly, std::unordered_set<uint64_t>& seen, std::vector<ConnectFourBoard>& out) {
+        bool mirrored;
+        if (!seen.insert(OpeningBook::canonicalKey(board, mirrored)).second)
+            return;
+        out.push_back(board);
+        if (board.moves >= maxPly)
+            return;
+
+        for (int col = 0; col < ConnectFourBoard::COLS; ++col) {
+            if (!board.canPlay(col) || board.isWinningMove(col))
+                continue;   // finished games need no book move
+            board.play(col);
+            enumerate(board, maxPly, seen, out);
+            board.undo(col);
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    int maxPly = 4;
+    int timeMs = 1000;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    size_t ttMB = 256;
+    std::string outPath = "connectfour_book.bin";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--ply")) maxPly = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--time-ms")) timeMs = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--threads")) threads = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--tt-mb")) ttMB = static_cast<size_t>(atoi(argv[i + 1]));
+        else if (!strcmp(argv[i], "--out")) outPath = argv[i + 1];
+    }
+
+    ConnectFourBoard root;
+    root.reset();
+    std::unordered_set<uint64_t> seen;
+    std::vector<ConnectFourBoard> positions;
+    enumerate(root, maxPly, seen, positions);
+    printf("%zu positions up to ply %d, %d ms each\n", positions.size(), maxPly, timeMs);
+
+    ConnectFourSearch search(ttMB, threads);
+    std::vector<uint64_t> records;
+    records.reserve(positions.size());
+    int solved = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const ConnectFourBoard& board = positions[i];
+        SearchResult r = search.search(board, timeMs);
+        bool mirrored;
+        uint64_t key = OpeningBook::canonicalKey(board, mirrored);
+        int move = mirrored ? ConnectFourBoard::COLS - 1 - r.move : r.move;
+        records.push_back(OpeningBook::packRecord(key, move, r.score));
+        solved += r.solved;
+
+        if ((i + 1) % 100 == 0 || i + 1 == positions.size())
+            printf("  %zu/%zu done, %d solved\n", i + 1, positions.size(), solved);
+    }
+
+    if (!OpeningBook::write(outPath, maxPly, records)) {
+        fprintf(stderr, "failed to write %s\n", outPath.c_str());
+        return 1;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    printf("wrote %s: %zu entries, %zu bytes, %.1fs\n", outPath.c_str(), records.size(),
+        sizeof(OpeningBook::Header) + records.size() * sizeof(uint64_t), secs);
+    return 0;
+}
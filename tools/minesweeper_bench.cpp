@@ -0,0 +1,89 @@
+// Headless Minesweeper reveal benchmark: one click on a blank tile of a large board.
+// Usage: minesweeper_bench [--rows N] [--cols N] [--mines N] [--boards N] [--seed N]
+// Each board is clicked at the blank tile nearest its centre; board setup is timed
+// separately from the flood fill.
+#include "core/minesweeper_core.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace core;
+
+namespace {
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Blank tiles flood; search outwards from the centre row by row for the closest one
+    bool findBlank(const MinesweeperGame& game, int& row, int& col) {
+        int midRow = game.rows / 2;
+        for (int d = 0; d <= game.rows; ++d) {
+            for (int r : { midRow - d, midRow + d }) {
+                if (r < 0 || r >= game.rows) continue;
+                for (int c = 0; c < game.cols; ++c) {
+                    const MinesweeperTile& t = game.at(r, c);
+                    if (!t.mine() && t.adjacentMines() == 0) {
+                        row = r;
+                        col = c;
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    int rows = 4000, cols = 4000;
+    int mines = -1;
+    int boards = 5;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) break;
+        if (!strcmp(argv[i], "--rows")) rows = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--cols")) cols = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--mines")) mines = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--boards")) boards = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed")) seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    }
+    if (mines < 0)
+        mines = static_cast<int>(static_cast<long long>(rows) * cols / 100);   // 1% density by default
+
+    MinesweeperGame game(rows, cols, mines);
+    printf("%dx%d, %d mines, %d boards\n", game.rows, game.cols, game.numMines, boards);
+    printf("%6s %10s %12s %10s %12s %6s\n", "board", "setup ms", "revealed", "fill ms", "Mcells/s", "won");
+
+    double setupTotal = 0, fillTotal = 0;
+    long long revealedTotal = 0;
+    for (int b = 0; b < boards; ++b) {
+        auto start = std::chrono::steady_clock::now();
+        game.reset(seed + b);
+        double setup = secondsSince(start);
+
+        int row, col;
+        if (!findBlank(game, row, col)) {
+            printf("%6d %10.1f   no blank tile\n", b, setup * 1000);
+            continue;
+        }
+        int before = game.safeTilesLeft();
+        start = std::chrono::steady_clock::now();
+        game.apply(MinesweeperGame::REVEAL, row, col);
+        double fill = secondsSince(start);
+        int revealed = before - game.safeTilesLeft();
+
+        printf("%6d %10.1f %12d %10.2f %12.1f %6s\n", b, setup * 1000, revealed, fill * 1000,
+            revealed / fill / 1e6, game.won ? "yes" : "no");
+        setupTotal += setup;
+        fillTotal += fill;
+        revealedTotal += revealed;
+    }
+
+    if (fillTotal > 0)
+        printf("total: setup %.1f ms/board, %lld cells revealed at %.1f Mcells/s\n",
+            setupTotal * 1000 / boards, revealedTotal, revealedTotal / fillTotal / 1e6);
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Headless Minesweeper solver benchmark: the solver plays seeded boards at several sizes.
+// Usage: minesweeper_solve [--games N] [--huge-games N] [--generate N] [--threads N] [--seed N]
+//                          [--max-latency-ms N]
+// Board i of a level uses seed + i, so a run is repeatable for any thread count.
+// Move latency is the time for one next() call, which is what a hint costs in game.
+// The run fails (exit code 1) when any level's slowest call exceeds --max-latency-ms,
+// one 60 Hz frame by default.
+// Afterwards --generate no-guess boards per level (not huge) are built single-threaded
+// to report how many candidates each one takes.
+#include "core/minesweeper_generator.hpp"
+#include "core/minesweeper_solver.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+    struct Level {
+        const char* name;
+        int rows, cols, mines;
+    };
+
+    struct LevelTotals {
+        int games = 0;
+        int won = 0;
+        long long revealed = 0;
+        long long moves = 0;
+        long long guesses = 0;
+        double seconds = 0;
+        std::vector<double> latency;    // microseconds per move
+
+        void merge(const LevelTotals& o) {
+            games += o.games; won += o.won; revealed += o.revealed;
+            moves += o.moves; guesses += o.guesses; seconds += o.seconds;
+            latency.insert(latency.end(), o.latency.begin(), o.latency.end());
+        }
+    };
+
+    void playGames(std::atomic<int>& next, int games, uint32_t seed, const Level& level, LevelTotals& totals) {
+        MinesweeperGame game(level.rows, level.cols, level.mines);
+        MinesweeperSolver solver;
+        for (int i = next++; i < games; i = next++) {
+            game.reset(seed + i);
+            auto start = std::chrono::steady_clock::now();
+            solver.reset(game);
+            long long guessesBefore = solver.guesses;
+            while (!game.gameOver) {
+                auto moveStart = std::chrono::steady_clock::now();
+                MinesweeperSolver::Move move = solver.next(game);
+                totals.latency.push_back(std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - moveStart).count());
+                if (move.reason == MinesweeperSolver::NONE) break;
+                totals.moves++;
+                if (move.reason == MinesweeperSolver::MINE) {
+                    game.apply(MinesweeperGame::FLAG, move.row, move.col);
+                    continue;
+                }
+                game.apply(MinesweeperGame::REVEAL, move.row, move.col);
+                solver.observe(game, move.row, move.col);
+            }
+            totals.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            totals.games++;
+            totals.won += game.won;
+            totals.guesses += solver.guesses - guessesBefore;
+            totals.revealed += static_cast<long long>(game.rows) * game.cols - game.numMines - game.safeTilesLeft();
+        }
+    }
+
+    double percentile(std::vector<double>& values, double p) {
+        if (values.empty()) return 0;
+        size_t k = std::min(values.size() - 1, static_cast<size_t>(p * values.size()));
+        std::nth_element(values.begin(), values.begin() + k, values.end());
+        return values[k];
+    }
+
+}
+
+int main(int argc, char** argv) {
+    int games = 2000;
+    int hugeGames = 4;
+    int generate = 200;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    uint32_t seed = 1;
+    double maxLatencyMs = 16.7;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) break;
+        if (!strcmp(argv[i], "--games")) games = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--huge-games")) hugeGames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--generate")) generate = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads")) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed")) seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (!strcmp(argv[i], "--max-latency-ms")) maxLatencyMs = atof(argv[++i]);
+    }
+    if (threads < 1) threads = 1;
+
+    const Level levels[] = {
+        { "beginner", 9, 9, 10 },
+        { "intermediate", 16, 16, 40 },
+        { "expert", 16, 30, 99 },
+        { "huge", 1000, 1000, 150000 },
+    };
+
+    int slowLevels = 0;
+    printf("%-13s %7s %8s %10s %10s %12s %9s %9s %9s\n", "level", "games", "win %", "guesses", "ms/board",
+        "cells/s", "p50 us", "p99 us", "max us");
+    for (const Level& level : levels) {
+        int count = level.rows * level.cols > 100000 ? hugeGames : games;
+        std::atomic<int> next(0);
+        std::vector<LevelTotals> perThread(threads);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t)
+            pool.emplace_back(playGames, std::ref(next), count, seed, std::cref(level), std::ref(perThread[t]));
+        for (std::thread& t : pool)
+            t.join();
+
+        LevelTotals totals;
+        for (const LevelTotals& t : perThread)
+            totals.merge(t);
+        if (totals.games == 0) continue;
+
+        double maxLatency = totals.latency.empty() ? 0 : *std::max_element(totals.latency.begin(), totals.latency.end());
+        printf("%-13s %7d %7.1f%% %10.2f %10.3f %12.0f %9.1f %9.1f %9.0f\n", level.name, totals.games,
+            100.0 * totals.won / totals.games, double(totals.guesses) / totals.games,
+            1000 * totals.seconds / totals.games, totals.revealed / totals.seconds,
+            percentile(totals.latency, 0.50), percentile(totals.latency, 0.99), maxLatency);
+        if (maxLatency > maxLatencyMs * 1000) {
+            printf("  FAIL: slowest next() took %.1f ms, over the %.1f ms limit\n", maxLatency / 1000, maxLatencyMs);
+            slowLevels++;
+        }
+    }
+
+    if (generate <= 0) return slowLevels > 0;
+    printf("\n%-13s %7s %10s %10s %9s\n", "no-guess", "boards", "ms/board", "attempts", "fallback");
+    for (const Level& level : levels) {
+        if (level.rows * level.cols > 100000) continue;
+        MinesweeperBoardSpec spec = { level.rows, level.cols, level.mines, true };
+        long long attempts = 0;
+        int fallbacks = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < generate; ++i) {
+            int tries = 0;
+            fallbacks += !generateMinesweeperBoard(spec, seed + i, 2000, &tries).noGuess;
+            attempts += tries;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("%-13s %7d %10.3f %10.1f %9d\n", level.name, generate, 1000 * seconds / generate,
+            double(attempts) / generate, fallbacks);
+    }
+    return slowLevels > 0;
+}
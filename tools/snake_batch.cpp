@@ -0,0 +1,132 @@
+// Headless Snake load generator: plays seeded games with the autopilot on every core.
+// Usage: snake_batch [--games N] [--threads N] [--seed N] [--cols N] [--rows N] [--max-ticks N]
+// Game i uses seed + i, so a run is repeatable for any thread count.
+// The playfield must not be odd in both directions: the autopilot has no Hamiltonian
+// cycle there and can circle without eating until the tick cap.
+#include "core/snake_autopilot.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+    // Decision latency histogram, 50 ns buckets up to 1 ms plus an overflow bucket
+    const int BUCKET_NS = 50;
+    const int BUCKETS = 20000;
+
+    struct BatchTotals {
+        long long ticks = 0;
+        long long score = 0;
+        long long length = 0;
+        int games = 0;
+        int won = 0;
+        int died = 0;
+        int capped = 0;
+        std::vector<long long> latency = std::vector<long long>(BUCKETS + 1, 0);
+
+        void merge(const BatchTotals& o) {
+            ticks += o.ticks; score += o.score; length += o.length;
+            games += o.games; won += o.won; died += o.died; capped += o.capped;
+            for (int i = 0; i <= BUCKETS; ++i) latency[i] += o.latency[i];
+        }
+
+        double percentileMicros(double p) const {
+            long long total = 0;
+            for (long long n : latency) total += n;
+            long long target = static_cast<long long>(p * total);
+            long long seen = 0;
+            for (int i = 0; i <= BUCKETS; ++i) {
+                seen += latency[i];
+                if (seen > target) return (i + 1) * BUCKET_NS / 1000.0;
+            }
+            return BUCKETS * BUCKET_NS / 1000.0;
+        }
+    };
+
+    void playGames(std::atomic<int>& next, int games, uint32_t seed, int cols, int rows,
+        long long maxTicks, BatchTotals& totals) {
+        SnakeGame game(cols, rows);
+        SnakeAutopilot pilot;
+        for (int i = next++; i < games; i = next++) {
+            game.reset(seed + i);
+            long long ticks = 0;
+            while (!game.gameOver && ticks < maxTicks) {
+                auto start = std::chrono::steady_clock::now();
+                Direction d = pilot.decide(game);
+                long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                totals.latency[ns / BUCKET_NS < BUCKETS ? ns / BUCKET_NS : BUCKETS]++;
+                game.apply(d);
+                game.tick();
+                ++ticks;
+            }
+            totals.ticks += ticks;
+            totals.score += game.score;
+            totals.length += static_cast<long long>(game.snake.segments.size());
+            totals.games++;
+            if (game.won) totals.won++;
+            else if (game.gameOver) totals.died++;
+            else totals.capped++;
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    int games = 1000;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    uint32_t seed = 1;
+    int cols = 40, rows = 30;
+    long long maxTicks = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) break;
+        if (!strcmp(argv[i], "--games")) games = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads")) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed")) seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (!strcmp(argv[i], "--cols")) cols = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rows")) rows = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--max-ticks")) maxTicks = atoll(argv[++i]);
+    }
+    if (threads < 1) threads = 1;
+    if (cols < 16 || rows < 16) {
+        fprintf(stderr, "board must be at least 16x16\n");
+        return 1;
+    }
+    SnakeAutopilot probe;
+    if (!probe.hasCycle(SnakeGame(cols, rows))) {
+        fprintf(stderr, "playfield of a %dx%d board is odd both ways, so the autopilot has no cycle to follow; "
+            "make cols or rows even\n", cols, rows);
+        return 1;
+    }
+
+    std::atomic<int> next(0);
+    std::vector<BatchTotals> perThread(threads);
+    std::vector<std::thread> pool;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back(playGames, std::ref(next), games, seed, cols, rows, maxTicks, std::ref(perThread[t]));
+    for (std::thread& t : pool)
+        t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    BatchTotals totals;
+    for (const BatchTotals& t : perThread)
+        totals.merge(t);
+    if (totals.games == 0) return 1;
+
+    printf("%d games on %dx%d, %d threads, %.2f s\n", totals.games, cols, rows, threads, seconds);
+    printf("won %d, died %d, hit tick cap %d\n", totals.won, totals.died, totals.capped);
+    printf("games/sec %.2f, ticks/sec %.0f (%.0f per thread)\n", totals.games / seconds,
+        totals.ticks / seconds, totals.ticks / seconds / threads);
+    printf("mean score %.1f, mean length %.1f, mean ticks %.0f\n", double(totals.score) / totals.games,
+        double(totals.length) / totals.games, double(totals.ticks) / totals.games);
+    printf("decision latency p50 %.2f us, p99 %.2f us\n", totals.percentileMicros(0.50),
+        totals.percentileMicros(0.99));
+    return 0;
+}